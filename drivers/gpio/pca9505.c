@@ -32,6 +32,9 @@ enum {
     CMD_CONFIG_4,
 };
 
+// Command flag making the register address auto-increment across a bank
+#define CMD_AUTO_INCREMENT 0x80
+
 void pca9505_init(uint8_t slave_addr) {
     static uint8_t s_init = 0;
     if (!s_init) {
@@ -162,3 +165,15 @@ bool pca9505_read_pins(uint8_t slave_addr, pca9505_port_t port, uint8_t* out) {
 
     return true;
 }
+
+bool pca9505_read_pins_all(uint8_t slave_addr, uint8_t out[PCA9505_PORT_COUNT]) {
+    uint8_t addr = SLAVE_TO_ADDR(slave_addr);
+
+    i2c_status_t ret = i2c_read_register(addr, CMD_INPUT_0 | CMD_AUTO_INCREMENT, out, PCA9505_PORT_COUNT, TIMEOUT);
+    if (ret != I2C_STATUS_SUCCESS) {
+        print("pca9505_read_pins_all::FAILED\n");
+        return false;
+    }
+
+    return true;
+}
@@ -17,6 +17,8 @@ typedef enum {
     PCA9505_PORT4,
 } pca9505_port_t;
 
+#define PCA9505_PORT_COUNT 5
+
 /**
  * Helpers for set_config
  */
@@ -66,6 +68,11 @@ bool pca9505_set_output(uint8_t slave_addr, pca9505_port_t port, uint8_t conf);
  */
 bool pca9505_read_pins(uint8_t slave_addr, pca9505_port_t port, uint8_t* ret);
 
+/**
+ * Read state of all five ports in a single transaction
+ */
+bool pca9505_read_pins_all(uint8_t slave_addr, uint8_t ret[PCA9505_PORT_COUNT]);
+
 // DEPRECATED - DO NOT USE
 
 #define pca9505_readPins pca9505_read_pins
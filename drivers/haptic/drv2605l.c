@@ -17,18 +17,29 @@
 
 #include "drv2605l.h"
 #include "i2c_master.h"
+#if defined(I2C_QUEUE_ENABLE)
+#    include "i2c_queue.h"
+#endif
 #include <math.h>
 
 uint8_t drv2605l_write_buffer[2];
 uint8_t drv2605l_read_buffer;
 
 void drv2605l_write(uint8_t reg_addr, uint8_t data) {
+#if defined(I2C_QUEUE_ENABLE)
+    i2c_queue_write_register(DRV2605L_I2C_ADDRESS << 1, reg_addr, &data, 1, 100, 0, I2C_QUEUE_PRIORITY_HIGH, NULL, NULL);
+#else
     drv2605l_write_buffer[0] = reg_addr;
     drv2605l_write_buffer[1] = data;
     i2c_transmit(DRV2605L_I2C_ADDRESS << 1, drv2605l_write_buffer, 2, 100);
+#endif
 }
 
 uint8_t drv2605l_read(uint8_t reg_addr) {
+#if defined(I2C_QUEUE_ENABLE)
+    // Make sure any queued writes have landed first
+    i2c_queue_flush();
+#endif
     i2c_read_register(DRV2605L_I2C_ADDRESS << 1, reg_addr, &drv2605l_read_buffer, 1, 100);
 
     return drv2605l_read_buffer;
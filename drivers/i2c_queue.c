@@ -0,0 +1,183 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "i2c_queue.h"
+
+typedef struct {
+    i2c_queue_callback_t callback;
+    void                *context;
+    uint8_t             *rx;
+    uint16_t             offset;    // start of the write data in the queue's buffer
+    uint16_t             footprint; // bytes of the queue's buffer held by the job
+    uint16_t             length;
+    uint16_t             timeout;
+    uint8_t              devaddr;
+    uint8_t              regaddr;
+    uint8_t              persistence;
+    bool                 read;
+} i2c_queue_job_t;
+
+typedef struct {
+    i2c_queue_job_t jobs[I2C_QUEUE_SIZE];
+    uint8_t         buffer[I2C_QUEUE_BUFFER_SIZE];
+    uint16_t        buffer_head;
+    uint16_t        buffer_used;
+    uint8_t         head;
+    uint8_t         count;
+} i2c_queue_t;
+
+static i2c_queue_t queues[I2C_QUEUE_PRIORITY_COUNT];
+
+static i2c_status_t i2c_queue_perform(const i2c_queue_job_t *job, const uint8_t *tx) {
+    uint8_t      attempts = job->persistence ? job->persistence : 1;
+    i2c_status_t status;
+    do {
+        if (job->read) {
+            status = i2c_read_register(job->devaddr, job->regaddr, job->rx, job->length, job->timeout);
+        } else {
+            status = i2c_write_register(job->devaddr, job->regaddr, tx, job->length, job->timeout);
+        }
+    } while (status != I2C_STATUS_SUCCESS && --attempts);
+    return status;
+}
+
+static void i2c_queue_run(i2c_queue_t *queue) {
+    // Copy the job out and release its slot and data once it has been
+    // performed, so that the callback is free to queue follow-up work.
+    i2c_queue_job_t job = queue->jobs[queue->head];
+
+    i2c_status_t status = i2c_queue_perform(&job, &queue->buffer[job.offset]);
+
+    queue->head = (queue->head + 1) % I2C_QUEUE_SIZE;
+    queue->count--;
+    queue->buffer_head = (queue->buffer_head + job.footprint) % I2C_QUEUE_BUFFER_SIZE;
+    queue->buffer_used -= job.footprint;
+    if (!queue->buffer_used) {
+        queue->buffer_head = 0;
+    }
+
+    if (job.callback) {
+        job.callback(status, job.context);
+    }
+}
+
+// Finds room for `length` contiguous bytes after the newest data in the
+// buffer, wrapping around to the start if the end is too short.
+static bool i2c_queue_reserve(const i2c_queue_t *queue, uint16_t length, uint16_t *offset, uint16_t *footprint) {
+    const uint16_t tail = (queue->buffer_head + queue->buffer_used) % I2C_QUEUE_BUFFER_SIZE;
+
+    if (queue->buffer_used == I2C_QUEUE_BUFFER_SIZE) {
+        return length == 0;
+    }
+
+    if (tail < queue->buffer_head) {
+        if (length > queue->buffer_head - tail) {
+            return false;
+        }
+        *offset    = tail;
+        *footprint = length;
+    } else if (length <= I2C_QUEUE_BUFFER_SIZE - tail) {
+        *offset    = tail;
+        *footprint = length;
+    } else if (length <= queue->buffer_head) {
+        *offset    = 0;
+        *footprint = I2C_QUEUE_BUFFER_SIZE - tail + length;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static i2c_queue_job_t *i2c_queue_push(i2c_queue_priority_t priority, uint16_t length) {
+    i2c_queue_t *queue     = &queues[priority];
+    uint16_t     offset    = 0;
+    uint16_t     footprint = 0;
+
+    while (queue->count >= I2C_QUEUE_SIZE || !i2c_queue_reserve(queue, length, &offset, &footprint)) {
+        i2c_queue_run(queue);
+    }
+
+    i2c_queue_job_t *job = &queue->jobs[(queue->head + queue->count) % I2C_QUEUE_SIZE];
+    queue->count++;
+    queue->buffer_used += footprint;
+
+    job->offset    = offset;
+    job->footprint = footprint;
+    return job;
+}
+
+void i2c_queue_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, uint8_t persistence, i2c_queue_priority_t priority, i2c_queue_callback_t callback, void *context) {
+    if (length > I2C_QUEUE_BUFFER_SIZE) {
+        // Too large to copy, so perform everything queued before it and then
+        // the write itself.
+        i2c_queue_job_t job = {.length = length, .timeout = timeout, .devaddr = devaddr, .regaddr = regaddr, .persistence = persistence};
+        i2c_queue_flush();
+        i2c_status_t status = i2c_queue_perform(&job, data);
+        if (callback) {
+            callback(status, context);
+        }
+        return;
+    }
+
+    i2c_queue_job_t *job = i2c_queue_push(priority, length);
+
+    // The data is copied, so the caller may reuse its buffer straight away.
+    memcpy(&queues[priority].buffer[job->offset], data, length);
+
+    job->rx          = NULL;
+    job->callback    = callback;
+    job->context     = context;
+    job->length      = length;
+    job->timeout     = timeout;
+    job->devaddr     = devaddr;
+    job->regaddr     = regaddr;
+    job->persistence = persistence;
+    job->read        = false;
+}
+
+void i2c_queue_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, uint8_t persistence, i2c_queue_priority_t priority, i2c_queue_callback_t callback, void *context) {
+    i2c_queue_job_t *job = i2c_queue_push(priority, 0);
+
+    job->rx          = data;
+    job->callback    = callback;
+    job->context     = context;
+    job->length      = length;
+    job->timeout     = timeout;
+    job->devaddr     = devaddr;
+    job->regaddr     = regaddr;
+    job->persistence = persistence;
+    job->read        = true;
+}
+
+static bool i2c_queue_run_next(void) {
+    for (uint8_t i = 0; i < I2C_QUEUE_PRIORITY_COUNT; i++) {
+        if (queues[i].count) {
+            i2c_queue_run(&queues[i]);
+            return true;
+        }
+    }
+    return false;
+}
+
+void i2c_queue_task(void) {
+    for (uint8_t i = 0; i < I2C_QUEUE_JOBS_PER_TASK; i++) {
+        if (!i2c_queue_run_next()) {
+            break;
+        }
+    }
+}
+
+void i2c_queue_flush(void) {
+    while (i2c_queue_run_next()) {
+    }
+}
+
+bool i2c_queue_is_empty(void) {
+    for (uint8_t i = 0; i < I2C_QUEUE_PRIORITY_COUNT; i++) {
+        if (queues[i].count) {
+            return false;
+        }
+    }
+    return true;
+}
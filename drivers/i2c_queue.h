@@ -0,0 +1,109 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "i2c_master.h"
+
+/**
+ * \file
+ *
+ * \defgroup i2c_queue I2C Transaction Queue API
+ *
+ * \brief API to defer I2C transactions so they are performed in small slices from the main loop.
+ *
+ * Transactions are queued with a priority and are carried out by `i2c_queue_task()`, which performs at most
+ * `I2C_QUEUE_JOBS_PER_TASK` of them per call. High priority jobs are always performed before any pending low
+ * priority jobs, so that sensor reads are not held up behind a large LED flush.
+ *
+ * Jobs with the same priority are performed in the order they were queued. Write data is copied into a buffer
+ * of `I2C_QUEUE_BUFFER_SIZE` bytes per priority when the job is queued, so the caller may change or reuse its own
+ * buffer straight away. The buffer of a read must remain valid until the job has completed.
+ * \{
+ */
+
+#ifndef I2C_QUEUE_SIZE
+#    define I2C_QUEUE_SIZE 32
+#endif
+
+#ifndef I2C_QUEUE_JOBS_PER_TASK
+#    define I2C_QUEUE_JOBS_PER_TASK 1
+#endif
+
+#ifndef I2C_QUEUE_BUFFER_SIZE
+#    define I2C_QUEUE_BUFFER_SIZE 256
+#endif
+
+typedef enum {
+    I2C_QUEUE_PRIORITY_HIGH,
+    I2C_QUEUE_PRIORITY_LOW,
+    I2C_QUEUE_PRIORITY_COUNT,
+} i2c_queue_priority_t;
+
+/**
+ * \brief Completion callback for a queued job.
+ *
+ * \param status The result of the transaction, as returned by the matching `i2c_master.h` function.
+ * \param context The context pointer passed when the job was queued.
+ */
+typedef void (*i2c_queue_callback_t)(i2c_status_t status, void *context);
+
+/**
+ * \brief Queue a write to a register with an 8-bit address on the I2C device.
+ *
+ * The data is copied into the queue. If the queue for the given priority is full, the oldest queued jobs are
+ * performed immediately to make room. A write larger than `I2C_QUEUE_BUFFER_SIZE` cannot be copied, so it is
+ * performed immediately, after every job queued before it.
+ *
+ * \param devaddr The 7-bit I2C address of the device.
+ * \param regaddr The register address to write to.
+ * \param data A pointer to the data to transmit.
+ * \param length The number of bytes to write. Take care not to overrun the length of `data`.
+ * \param timeout The time in milliseconds to wait for a response from the target device.
+ * \param persistence The number of attempts to make before giving up. `0` is the same as `1`.
+ * \param priority The priority of the job.
+ * \param callback The function to call once the job has completed, or `NULL`.
+ * \param context A pointer passed through to `callback`.
+ */
+void i2c_queue_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, uint8_t persistence, i2c_queue_priority_t priority, i2c_queue_callback_t callback, void *context);
+
+/**
+ * \brief Queue a read from a register with an 8-bit address on the I2C device.
+ *
+ * If the queue for the given priority is full, the oldest queued jobs are performed immediately to make room.
+ *
+ * \param devaddr The 7-bit I2C address of the device.
+ * \param regaddr The register address to read from.
+ * \param data A pointer to a buffer to read into.
+ * \param length The number of bytes to read. Take care not to overrun the length of `data`.
+ * \param timeout The time in milliseconds to wait for a response from the target device.
+ * \param persistence The number of attempts to make before giving up. `0` is the same as `1`.
+ * \param priority The priority of the job.
+ * \param callback The function to call once the job has completed, or `NULL`.
+ * \param context A pointer passed through to `callback`.
+ */
+void i2c_queue_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, uint8_t persistence, i2c_queue_priority_t priority, i2c_queue_callback_t callback, void *context);
+
+/**
+ * \brief Perform up to `I2C_QUEUE_JOBS_PER_TASK` queued jobs, highest priority first.
+ *
+ * This is called from the main loop and should not normally need to be called directly.
+ */
+void i2c_queue_task(void);
+
+/**
+ * \brief Perform every queued job before returning.
+ */
+void i2c_queue_flush(void);
+
+/**
+ * \brief Check whether any jobs are waiting to be performed.
+ *
+ * \return `true` if the queue is empty.
+ */
+bool i2c_queue_is_empty(void);
+
+/** \} */
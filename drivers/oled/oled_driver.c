@@ -384,7 +384,40 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
+// Number of consecutive dirty blocks from update_start (at most limit) that
+// form one rectangle on the panel, and so can be sent as a single transfer.
+// A run never exceeds OLED_UPDATE_MAX_TRANSFER bytes.
+static uint8_t calc_run(uint8_t update_start, uint8_t limit) {
+    const uint16_t start_offset = OLED_BLOCK_SIZE * update_start;
+    uint8_t        run          = 1;
+    for (uint8_t count = 2; count <= limit && update_start + count <= OLED_BLOCK_COUNT; ++count) {
+        if (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << (update_start + count - 1)))) {
+            break;
+        }
+        const uint16_t end_offset = start_offset + OLED_BLOCK_SIZE * count;
+        if (end_offset - start_offset > OLED_UPDATE_MAX_TRANSFER) {
+            break;
+        }
+        if (start_offset / OLED_DISPLAY_WIDTH == (end_offset - 1) / OLED_DISPLAY_WIDTH) {
+            // Still within a single page
+            run = count;
+        }
+#if OLED_IC_HAS_HORIZONTAL_MODE
+        else if (start_offset % OLED_DISPLAY_WIDTH == 0 && end_offset % OLED_DISPLAY_WIDTH == 0) {
+            // Whole pages, which the horizontal addressing mode wraps through
+            run = count;
+        }
+#else
+        else {
+            // Page Addressing Mode cannot move on to the next page by itself
+            break;
+        }
+#endif
+    }
+    return run;
+}
+
+static void calc_bounds(uint8_t update_start, uint8_t update_count, uint8_t *cmd_array) {
     // Calculate commands to set memory addressing bounds.
     uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
     uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
@@ -398,8 +431,8 @@ static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     // Commands for use in Horizontal Addressing mode.
     cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
     cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
+    cmd_array[2] = (OLED_BLOCK_SIZE * update_count + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
+    cmd_array[5] = (OLED_BLOCK_SIZE * update_count + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
 #endif
 }
 
@@ -460,12 +493,19 @@ void oled_render_dirty(bool all) {
 
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
-    while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
+    while (oled_dirty && (num_processed < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
         // Find next dirty block
         while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
             ++update_start;
         }
 
+        // Unrotated, adjacent dirty blocks are sent together
+        uint8_t update_count = 1;
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+            update_count = calc_run(update_start, all ? OLED_BLOCK_COUNT : OLED_UPDATE_PROCESS_LIMIT - num_processed);
+        }
+        num_processed += update_count;
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
         static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
@@ -473,7 +513,7 @@ void oled_render_dirty(bool all) {
         static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
 #endif
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+            calc_bounds(update_start, update_count, &display_start[1]); // Offset from I2C_CMD byte at the start
         } else {
             calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
         }
@@ -486,7 +526,7 @@ void oled_render_dirty(bool all) {
 
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE * update_count)) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -529,8 +569,9 @@ void oled_render_dirty(bool all) {
 #endif
         }
 
-        // Clear dirty flag of just rendered block
-        oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        // Clear dirty flags of just rendered blocks
+        oled_dirty &= ~((OLED_BLOCK_TYPE)(OLED_ALL_BLOCKS_MASK >> (OLED_BLOCK_COUNT - update_count)) << update_start);
+        update_start += update_count;
     }
 }
 
@@ -321,6 +321,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_PROCESS_LIMIT 1
 #endif
 
+// Largest number of bytes sent in one data transfer when adjacent dirty blocks are merged
+#if !defined(OLED_UPDATE_MAX_TRANSFER)
+#    define OLED_UPDATE_MAX_TRANSFER OLED_DISPLAY_WIDTH
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
@@ -184,7 +184,8 @@ tap_dance_action_t tap_dance_actions[] = {
 
 // Runs whenever a key is pressed or released.
 bool process_record_user(uint16_t keycode, keyrecord_t *record) {
-    tap_dance_action_t *action;
+    const tap_dance_action_t *action;
+    tap_dance_state_t        *state;
 
     switch (keycode) {
 
@@ -196,8 +197,9 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
         case TD(SFT_MORE):
         case TD(SFT_LCUR):
         case TD(ALT_RCUR):
-            action = &tap_dance_actions[QK_TAP_DANCE_GET_INDEX(keycode)];
-            if (!record->event.pressed && action->state.count && !action->state.finished) {
+            action = tap_dance_get(QK_TAP_DANCE_GET_INDEX(keycode));
+            state  = tap_dance_get_state(QK_TAP_DANCE_GET_INDEX(keycode));
+            if (!record->event.pressed && state && state->count && !state->finished) {
                 tap_dance_tap_hold_t *tap_hold = (tap_dance_tap_hold_t *)action->user_data;
                 tap_code16(tap_hold->tap);
             }
@@ -72,10 +72,11 @@ static void select_row(uint8_t row) {
 }
 
 static uint16_t read_cols(void) {
-  uint8_t state_1 = 0;
-  uint8_t state_2 = 0;
-  pca9555_read_pins(IC2, PCA9555_PORT0, &state_1);
-  pca9555_read_pins(IC2, PCA9555_PORT1, &state_2);
+  // Both ports in one transaction
+  uint16_t ports = 0;
+  pca9555_read_pins_all(IC2, &ports);
+  uint8_t state_1 = ports & 0xFF;
+  uint8_t state_2 = ports >> 8;
 
   uint16_t state = (((uint16_t)state_1 & PORT0_COLS_MASK) << 3) | (((uint16_t)state_2 & PORT1_COLS_MASK));
 
@@ -44,12 +44,12 @@ static void select_row(uint8_t row) {
 
 static uint32_t read_cols(void) {
     //Read column inputs. Pins 13-31 are used. Split across both ICs but they are sequential
-    uint8_t state_1 = 0;
-    uint8_t state_2 = 0;
-    uint8_t state_3 = 0;
+    uint8_t  state_1 = 0;
+    uint16_t ports   = 0;
     pca9555_read_pins(IC1, PCA9555_PORT1, &state_1);
-    pca9555_read_pins(IC2, PCA9555_PORT0, &state_2);
-    pca9555_read_pins(IC2, PCA9555_PORT1, &state_3);
+    pca9555_read_pins_all(IC2, &ports); // both IC2 ports in one transaction
+    uint8_t state_2 = ports & 0xFF;
+    uint8_t state_3 = ports >> 8;
 
     uint32_t state = ((((uint32_t)state_3 & 0b01111111) << 12) | ((uint32_t)state_2 << 4) | (((uint32_t)state_1 & 0b11110000) >> 4));
     return ~state;
@@ -44,12 +44,13 @@ static void select_row(uint8_t row) {
 }
 
 static uint32_t read_cols(void) {
-  uint8_t state_1 = 0;
-  uint8_t state_2 = 0;
-  uint8_t state_3 = 0;
-  pca9555_read_pins(IC2, PCA9555_PORT0, &state_1);
-  pca9555_read_pins(IC2, PCA9555_PORT1, &state_2);
+  // Both IC2 ports in one transaction
+  uint16_t ports   = 0;
+  uint8_t  state_3 = 0;
+  pca9555_read_pins_all(IC2, &ports);
   pca9555_read_pins(IC1, PCA9555_PORT1, &state_3);
+  uint8_t state_1 = ports & 0xFF;
+  uint8_t state_2 = ports >> 8;
 
   // For the XD96 the pins are mapped to port expanders as follows:
   //   all 8 pins port 0 IC2, first 6 pins port 1 IC2, first 4 pins port 1 IC1
@@ -165,32 +165,56 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
+def make_leaf_data(typo: str, correction: str) -> List[int]:
+    """Makes the serialized leaf data (backspace count and replacement string) of a typo."""
+    word_boundary_ending = typo[-1] == ':'
+    typo = typo.strip(':')
+    i = 0  # Make the autocorrection data for this entry and serialize it.
+    while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+        i += 1
+    backspaces = len(typo) - i - 1 + word_boundary_ending
+    assert 0 <= backspaces <= 63
+    correction = correction[i:]
+    bs_count = [backspaces + 128]
+    return bs_count + list(bytes(correction, 'ascii')) + [0]
+
+
+def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any], merge: bool = True) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
+  Identical subtrees are only serialized once and linked to from every place
+  they occur, turning the trie into a DAWG. Large dictionaries have many typos
+  sharing the same leading characters and correction, so this keeps them well
+  within the 64KB link range.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
+    merge: Whether to merge identical subtrees. Without it every node is
+      serialized where it occurs, as a plain trie.
   Returns:
     List of ints in the range 0-255.
   """
     table = []
+    keys = {}
+    emitted = {}  # Subtree key -> (entry, serialized size).
+
+    def subtree_key(trie_node):
+        """Key identifying a subtree by what it decodes to."""
+        if id(trie_node) not in keys:
+            if 'LEAF' in trie_node:
+                keys[id(trie_node)] = tuple(make_leaf_data(*trie_node['LEAF']))
+            else:
+                keys[id(trie_node)] = tuple((c, subtree_key(child)) for c, child in sorted(trie_node.items()))
+        return keys[id(trie_node)]
 
     # Traverse trie in depth first order.
-    def traverse(trie_node):
+    def traverse(trie_node, linked=True):
+        key = subtree_key(trie_node)
+        if merge and linked and key in emitted:  # Link to the existing copy.
+            return emitted[key][0]
+
+        start = len(table)
         if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
-            word_boundary_ending = typo[-1] == ':'
-            typo = typo.strip(':')
-            i = 0  # Make the autocorrection data for this entry and serialize it.
-            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
-                i += 1
-            backspaces = len(typo) - i - 1 + word_boundary_ending
-            assert 0 <= backspaces <= 63
-            correction = correction[i:]
-            bs_count = [backspaces + 128]
-            data = bs_count + list(bytes(correction, 'ascii')) + [0]
-
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
+            entry = {'data': make_leaf_data(*trie_node['LEAF']), 'links': [], 'byte_offset': 0}
             table.append(entry)
         elif len(trie_node) == 1:  # Handle trie node with a single child.
             c, trie_node = next(iter(trie_node.items()))
@@ -202,20 +226,34 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
                 c, trie_node = next(iter(trie_node.items()))
                 entry['chars'] += c
 
-            table.append(entry)
-            entry['links'] = [traverse(trie_node)]
+            # The child of a chain is encoded immediately after it. If the child
+            # already exists and is bigger than the cost of a link, end the chain
+            # with a single branch to it rather than serializing another copy.
+            shared = emitted.get(subtree_key(trie_node)) if merge else None
+            if shared and shared[1] > 3:
+                last = {'chars': entry['chars'][-1], 'links': [shared[0]], 'branch': True, 'byte_offset': 0}
+                entry['chars'] = entry['chars'][:-1]
+                if entry['chars']:
+                    table.append(entry)
+                    entry['links'] = [last]
+                else:
+                    entry = last
+                table.append(last)
+            else:
+                table.append(entry)
+                entry['links'] = [traverse(trie_node, linked=False)]
         else:  # Handle trie node with multiple children.
-            entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
+            entry = {'chars': ''.join(sorted(trie_node.keys())), 'branch': True, 'byte_offset': 0}
             table.append(entry)
             entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
-        return entry
 
-    traverse(trie)
+        emitted.setdefault(key, (entry, sum(len(serialize(e)) for e in table[start:])))
+        return entry
 
     def serialize(e: Dict[str, Any]) -> List[int]:
         if not e['links']:  # Handle a leaf table entry.
             return e['data']
-        elif len(e['links']) == 1:  # Handle a chain table entry.
+        elif not e.get('branch'):  # Handle a chain table entry.
             return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
         else:  # Handle a branch table entry.
             data = []
@@ -223,6 +261,8 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
                 data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
             return data + [0]
 
+    traverse(trie)
+
     byte_offset = 0
     for e in table:  # To encode links, first compute byte offset of each entry.
         e['byte_offset'] = byte_offset
@@ -0,0 +1,80 @@
+from qmk.cli.generate.autocorrect_data import TYPO_CHARS, make_leaf_data, make_trie, serialize_trie
+
+# Several typos share their leading characters and correction, so the merged
+# table links to shared subtrees instead of repeating them.
+AUTOCORRECTIONS = [
+    ('recieve', 'receive'),
+    ('decieve', 'deceive'),
+    ('concieve', 'conceive'),
+    ('percieve', 'perceive'),
+    ('acheive', 'achieve'),
+    ('beleive', 'believe'),
+    ('releive', 'relieve'),
+    (':thier', 'their'),
+    ('fitler', 'filter'),
+    ('lenght', 'length'),
+    ('ouput', 'output'),
+    ('widht', 'width'),
+    ('aparent', 'apparent'),
+    ('transparant', 'transparent'),
+    ('accomodate', 'accommodate'),
+    ('comitted:', 'committed'),
+    ("didnt'", "didn't"),
+]
+
+
+def lookup(data, text):
+    """Looks `text` up the same way process_autocorrect() does, returning the leaf data of the typo it ends with."""
+    state = 0
+    code = data[state]
+    for c in reversed(text):
+        key = TYPO_CHARS[c]
+        if code & 64:  # Node with multiple children.
+            code &= 63
+            while code != key:
+                if not code:
+                    return None
+                state += 3
+                code = data[state]
+            state = data[state + 1] | data[state + 2] << 8
+        elif code != key:  # Node with a single child.
+            return None
+        else:
+            state += 1
+            if not data[state]:
+                state += 1
+
+        assert state < len(data)
+        code = data[state]
+        if code & 128:  # Leaf.
+            return data[state:data.index(0, state + 1) + 1]
+    return None
+
+
+def queries():
+    """Every prefix of every typo, on its own and after a few other characters."""
+    for typo, _ in AUTOCORRECTIONS:
+        for length in range(1, len(typo) + 1):
+            for prefix in ('', ':', 'x', 're', 'con', "'"):
+                yield prefix + typo[:length]
+
+
+def test_merged_autocorrect_data_is_smaller():
+    trie = make_trie(AUTOCORRECTIONS)
+    merged = serialize_trie(AUTOCORRECTIONS, trie)
+    unmerged = serialize_trie(AUTOCORRECTIONS, trie, merge=False)
+
+    assert len(merged) < len(unmerged)
+
+
+def test_merged_autocorrect_data_decodes_like_unmerged():
+    trie = make_trie(AUTOCORRECTIONS)
+    merged = serialize_trie(AUTOCORRECTIONS, trie)
+    unmerged = serialize_trie(AUTOCORRECTIONS, trie, merge=False)
+
+    for typo, correction in AUTOCORRECTIONS:
+        assert lookup(unmerged, typo) == make_leaf_data(typo, correction)
+        assert lookup(merged, typo) == make_leaf_data(typo, correction)
+
+    for text in queries():
+        assert lookup(merged, text) == lookup(unmerged, text), text
@@ -38,3 +38,11 @@ typedef uint8_t pin_t;
 #define gpio_read_pin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
 
 #define gpio_toggle_pin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin)&0xF))
+
+/* Operation of GPIO by port. */
+
+typedef uint8_t port_data_t;
+
+#define gpio_read_port(pin) (PINx_ADDRESS(pin))
+#define gpio_pin_mask(pin) _BV((pin)&0xF)
+#define gpio_same_port(pin_a, pin_b) (((pin_a) >> PORT_SHIFTER) == ((pin_b) >> PORT_SHIFTER))
@@ -2,6 +2,8 @@
 #include "gpio.h"
 #include "chibios_config.h"
 
+#include <string.h>
+
 // ======== DEPRECATED DEFINES - DO NOT USE ========
 #ifdef WS2812_DMA_STREAM
 #    define WS2812_PWM_DMA_STREAM WS2812_DMA_STREAM
@@ -394,13 +396,21 @@ void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b,
 
 ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
 
+// LEDs whose color has changed since they were last encoded
+static uint8_t ws2812_dirty[(WS2812_LED_COUNT + 7) / 8];
+
 void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
-    ws2812_leds[index].r = red;
-    ws2812_leds[index].g = green;
-    ws2812_leds[index].b = blue;
+    ws2812_led_t led = {.r = red, .g = green, .b = blue};
 #if defined(WS2812_RGBW)
-    ws2812_rgb_to_rgbw(&ws2812_leds[index]);
+    ws2812_rgb_to_rgbw(&led);
 #endif
+    // Compare what would be stored, as the conversion may change the channels.
+    if (memcmp(&ws2812_leds[index], &led, sizeof(led)) == 0) {
+        return;
+    }
+
+    ws2812_leds[index] = led;
+    ws2812_dirty[index / 8] |= 1 << (index % 8);
 }
 
 void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -411,10 +421,14 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 
 void ws2812_flush(void) {
     for (int i = 0; i < WS2812_LED_COUNT; i++) {
+        if (!(ws2812_dirty[i / 8] & (1 << (i % 8)))) {
+            continue;
+        }
 #if defined(WS2812_RGBW)
         ws2812_write_led_rgbw(i, ws2812_leds[i].r, ws2812_leds[i].g, ws2812_leds[i].b, ws2812_leds[i].w);
 #else
         ws2812_write_led(i, ws2812_leds[i].r, ws2812_leds[i].g, ws2812_leds[i].b);
 #endif
     }
+    memset(ws2812_dirty, 0, sizeof(ws2812_dirty));
 }
@@ -3,6 +3,8 @@
 #include "util.h"
 #include "chibios_config.h"
 
+#include <string.h>
+
 /* Adapted from https://github.com/gamazeps/ws2812b-chibios-SPIDMA/ */
 
 // Define the spi your LEDs are plugged to here
@@ -121,16 +123,9 @@ static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
  * 0s and 1s for the LED (with the appropriate timing).
  */
 static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+    // Each byte carries two data bits, the more significant one in the high nibble.
+    static const uint8_t eq[4] = {0b10001000, 0b10001110, 0b11101000, 0b11101110};
+    return eq[(data >> (2 * (3 - pos))) & 0b11];
 }
 
 static void set_led_color_rgb(ws2812_led_t color, int pos) {
@@ -166,7 +161,13 @@ static void set_led_color_rgb(ws2812_led_t color, int pos) {
 
 ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
 
+// LEDs whose color has changed since they were last encoded
+static uint8_t ws2812_dirty[(WS2812_LED_COUNT + 7) / 8];
+
 void ws2812_init(void) {
+    // txbuf starts out zeroed rather than encoded, so encode every LED on the first flush.
+    memset(ws2812_dirty, 0xFF, sizeof(ws2812_dirty));
+
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
 #ifdef WS2812_SPI_SCK_PIN
@@ -225,12 +226,17 @@ void ws2812_init(void) {
 }
 
 void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
-    ws2812_leds[index].r = red;
-    ws2812_leds[index].g = green;
-    ws2812_leds[index].b = blue;
+    ws2812_led_t led = {.r = red, .g = green, .b = blue};
 #if defined(WS2812_RGBW)
-    ws2812_rgb_to_rgbw(&ws2812_leds[index]);
+    ws2812_rgb_to_rgbw(&led);
 #endif
+    // Compare what would be stored, as the conversion may change the channels.
+    if (memcmp(&ws2812_leds[index], &led, sizeof(led)) == 0) {
+        return;
+    }
+
+    ws2812_leds[index] = led;
+    ws2812_dirty[index / 8] |= 1 << (index % 8);
 }
 
 void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -241,8 +247,11 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 
 void ws2812_flush(void) {
     for (int i = 0; i < WS2812_LED_COUNT; i++) {
-        set_led_color_rgb(ws2812_leds[i], i);
+        if (ws2812_dirty[i / 8] & (1 << (i % 8))) {
+            set_led_color_rgb(ws2812_leds[i], i);
+        }
     }
+    memset(ws2812_dirty, 0, sizeof(ws2812_dirty));
 
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
@@ -43,3 +43,11 @@ typedef ioline_t pin_t;
 #define gpio_read_pin(pin) palReadLine(pin)
 
 #define gpio_toggle_pin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port. */
+
+typedef ioportmask_t port_data_t;
+
+#define gpio_read_port(pin) palReadPort(PAL_PORT(pin))
+#define gpio_pin_mask(pin) PAL_PORT_BIT(PAL_PAD(pin))
+#define gpio_same_port(pin_a, pin_b) (PAL_PORT(pin_a) == PAL_PORT(pin_b))
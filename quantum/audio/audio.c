@@ -21,6 +21,7 @@
 #include "wait.h"
 #include "util.h"
 #include "gpio.h"
+#include "progmem.h"
 
 /* audio system:
  *
@@ -83,6 +84,7 @@ bool state_changed  = false; // global flag, which is set if anything changes wi
 
 // melody/SONG related state variables
 float (*notes_pointer)[][2];                           // SONG, an array of MUSICAL_NOTEs
+const musical_note_t *packed_notes_pointer = NULL;     // PACKED_SONG in PROGMEM, used instead of notes_pointer when set
 uint16_t notes_count;                                  // length of the notes_pointer array
 bool     notes_repeat;                                 // PLAY_SONG or PLAY_LOOP?
 uint16_t melody_current_note_duration = 0;             // duration of the currently playing note from the active melody, in ms
@@ -357,6 +359,52 @@ void audio_play_tone(float pitch) {
     audio_play_note(pitch, 0xffff);
 }
 
+// pitches of the highest octave in 1/8 Hz, the lower octaves are worked out by halving
+static const uint16_t PROGMEM packed_note_pitches[12] = {
+    NOTE_C8 * 8, NOTE_CS8 * 8, NOTE_D8 * 8, NOTE_DS8 * 8, NOTE_E8 * 8, NOTE_F8 * 8, NOTE_FS8 * 8, NOTE_G8 * 8, NOTE_GS8 * 8, NOTE_A8 * 8, NOTE_AS8 * 8, NOTE_B8 * 8,
+};
+
+float audio_packed_note_to_pitch(uint8_t note) {
+    if (note == NOTE_INDEX_REST || note > NOTE_INDEX_B8) {
+        return 0.0f;
+    }
+    note--;
+    return (float)pgm_read_word(&packed_note_pitches[note % 12]) / (float)(8 << (8 - note / 12));
+}
+
+static float melody_note_pitch(uint16_t index) {
+    if (packed_notes_pointer) {
+        return audio_packed_note_to_pitch(pgm_read_byte(&packed_notes_pointer[index].note));
+    }
+    return (*notes_pointer)[index][0];
+}
+
+static uint16_t melody_note_duration(uint16_t index) {
+    if (packed_notes_pointer) {
+        return audio_duration_to_ms(pgm_read_byte(&packed_notes_pointer[index].duration));
+    }
+    return audio_duration_to_ms((*notes_pointer)[index][1]);
+}
+
+static void audio_start_melody(uint16_t n_count, bool n_repeat) {
+    // Cancel note if a note is playing
+    if (playing_note) audio_stop_all();
+
+    playing_melody = true;
+    note_resting   = false;
+
+    notes_count  = n_count;
+    notes_repeat = n_repeat;
+
+    current_note = 0; // note in the melody-array/list at note_pointer
+
+    // start first note manually, which also starts the audio_driver
+    // all following/remaining notes are played by 'audio_update_state'
+    melody_current_note_duration = melody_note_duration(current_note);
+    audio_play_note(melody_note_pitch(current_note), melody_current_note_duration);
+    last_timestamp = timer_read();
+}
+
 void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
     if (!audio_config.enable) {
         audio_stop_all();
@@ -371,23 +419,28 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
         audio_init();
     }
 
-    // Cancel note if a note is playing
-    if (playing_note) audio_stop_all();
+    notes_pointer        = np;
+    packed_notes_pointer = NULL;
+    audio_start_melody(n_count, n_repeat);
+}
 
-    playing_melody = true;
-    note_resting   = false;
+void audio_play_packed_melody(const musical_note_t *notes, uint16_t n_count, bool n_repeat) {
+    if (!audio_config.enable) {
+        audio_stop_all();
+        return;
+    }
 
-    notes_pointer = np;
-    notes_count   = n_count;
-    notes_repeat  = n_repeat;
+    if (n_count == 0) {
+        return;
+    }
 
-    current_note = 0; // note in the melody-array/list at note_pointer
+    if (!audio_initialized) {
+        audio_init();
+    }
 
-    // start first note manually, which also starts the audio_driver
-    // all following/remaining notes are played by 'audio_update_state'
-    audio_play_note((*notes_pointer)[current_note][0], audio_duration_to_ms((*notes_pointer)[current_note][1]));
-    last_timestamp               = timer_read();
-    melody_current_note_duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+    notes_pointer        = NULL;
+    packed_notes_pointer = notes;
+    audio_start_melody(n_count, n_repeat);
 }
 
 void audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
@@ -479,7 +532,7 @@ bool audio_update_state(void) {
                 }
             }
 
-            if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
+            if (!note_resting && melody_note_pitch(previous_note) == melody_note_pitch(current_note)) {
                 note_resting = true;
 
                 // special handling for successive notes of the same frequency:
@@ -503,13 +556,13 @@ bool audio_update_state(void) {
 
                 // '- delta': Skip forward in the next note's length if we've over shot
                 //            the last, so the overall length of the song is the same
-                uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                uint16_t duration = melody_note_duration(current_note);
 
                 // Skip forward past any completely missed notes
                 while (delta > duration && current_note < notes_count - 1) {
                     delta -= duration;
                     current_note++;
-                    duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                    duration = melody_note_duration(current_note);
                 }
 
                 if (delta < duration) {
@@ -520,7 +573,7 @@ bool audio_update_state(void) {
                     duration = 1;
                 }
 
-                audio_play_note((*notes_pointer)[current_note][0], duration);
+                audio_play_note(melody_note_pitch(current_note), duration);
                 melody_current_note_duration = duration;
             }
         }
@@ -145,6 +145,35 @@ void audio_stop_tone(float pitch);
  */
 void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat);
 
+/**
+ * @brief a note of a PACKED_SONG, see musical_notes.h
+ */
+typedef struct {
+    uint8_t note;     // semitone counted up from C0, 0 is a rest
+    uint8_t duration; // 64 parts to a beat
+} musical_note_t;
+
+/**
+ * @brief play a melody from packed notes
+ *
+ * @details same as audio_play_melody, but with a PACKED_SONG stored in
+ *          PROGMEM; the notes are read and converted one at a time while
+ *          playing
+ *
+ * @param[in] notes pointer to the PACKED_SONG array
+ * @param[in] n_count number of notes of the PACKED_SONG
+ * @param[in] n_repeat false for onetime, true for looped playback
+ */
+void audio_play_packed_melody(const musical_note_t *notes, uint16_t n_count, bool n_repeat);
+
+/**
+ * @brief convert the note of a packed song to its pitch
+ *
+ * @param[in] note semitone counted up from C0, 0 is a rest
+ * @return pitch in Hz, or 0.0f for a rest
+ */
+float audio_packed_note_to_pitch(uint8_t note);
+
 /**
  * @brief play a short tone of a specific frequency to emulate a 'click'
  *
@@ -190,6 +219,14 @@ bool audio_is_playing_melody(void);
  * @brief convenience macro, to play a melody/SONG in a loop, until stopped by 'audio_stop_all'
  */
 #define PLAY_LOOP(note_array) audio_play_melody(&note_array, NOTE_ARRAY_SIZE((note_array)), true)
+/**
+ * @brief convenience macro, to play a PACKED_SONG once
+ */
+#define PLAY_PACKED_SONG(note_array) audio_play_packed_melody(note_array, NOTE_ARRAY_SIZE((note_array)), false)
+/**
+ * @brief convenience macro, to play a PACKED_SONG in a loop, until stopped by 'audio_stop_all'
+ */
+#define PLAY_PACKED_LOOP(note_array) audio_play_packed_melody(note_array, NOTE_ARRAY_SIZE((note_array)), true)
 
 // Tone-Multiplexing functions
 // this feature only makes sense for hardware setups which can't do proper
@@ -232,3 +232,187 @@
 #define NOTE_GF8 NOTE_FS8
 #define NOTE_AF8 NOTE_GS8
 #define NOTE_BF8 NOTE_AS8
+
+// Packed Notes
+// Two bytes per note: the semitone counted up from C0 (0 being a rest), and the duration in the units above.
+// Durations are limited to 255, and the notes of a packed song are best kept in PROGMEM:
+//     const musical_note_t PROGMEM my_song[] = PACKED_SONG(PQ_NOTE(_C4), PE_NOTE(_E4), PH_NOTE(_G4));
+#define PACKED_SONG(notes...) \
+    { notes }
+
+#define PACKED_NOTE(note, duration) \
+    { (NOTE_INDEX##note), (duration) }
+
+#define PM_NOTE(note, duration) PACKED_NOTE(note, duration)
+#define PB_NOTE(n) PACKED_NOTE(n, 128)
+#define PW_NOTE(n) PACKED_NOTE(n, 64)
+#define PH_NOTE(n) PACKED_NOTE(n, 32)
+#define PQ_NOTE(n) PACKED_NOTE(n, 16)
+#define PE_NOTE(n) PACKED_NOTE(n, 8)
+#define PS_NOTE(n) PACKED_NOTE(n, 4)
+#define PT_NOTE(n) PACKED_NOTE(n, 2)
+#define PBD_NOTE(n) PACKED_NOTE(n, 128 + 64)
+#define PWD_NOTE(n) PACKED_NOTE(n, 64 + 32)
+#define PHD_NOTE(n) PACKED_NOTE(n, 32 + 16)
+#define PQD_NOTE(n) PACKED_NOTE(n, 16 + 8)
+#define PED_NOTE(n) PACKED_NOTE(n, 8 + 4)
+#define PSD_NOTE(n) PACKED_NOTE(n, 4 + 2)
+#define PTD_NOTE(n) PACKED_NOTE(n, 2 + 1)
+
+#define NOTE_INDEX_REST 0
+
+#define NOTE_INDEX_C0 1
+#define NOTE_INDEX_CS0 2
+#define NOTE_INDEX_D0 3
+#define NOTE_INDEX_DS0 4
+#define NOTE_INDEX_E0 5
+#define NOTE_INDEX_F0 6
+#define NOTE_INDEX_FS0 7
+#define NOTE_INDEX_G0 8
+#define NOTE_INDEX_GS0 9
+#define NOTE_INDEX_A0 10
+#define NOTE_INDEX_AS0 11
+#define NOTE_INDEX_B0 12
+#define NOTE_INDEX_C1 13
+#define NOTE_INDEX_CS1 14
+#define NOTE_INDEX_D1 15
+#define NOTE_INDEX_DS1 16
+#define NOTE_INDEX_E1 17
+#define NOTE_INDEX_F1 18
+#define NOTE_INDEX_FS1 19
+#define NOTE_INDEX_G1 20
+#define NOTE_INDEX_GS1 21
+#define NOTE_INDEX_A1 22
+#define NOTE_INDEX_AS1 23
+#define NOTE_INDEX_B1 24
+#define NOTE_INDEX_C2 25
+#define NOTE_INDEX_CS2 26
+#define NOTE_INDEX_D2 27
+#define NOTE_INDEX_DS2 28
+#define NOTE_INDEX_E2 29
+#define NOTE_INDEX_F2 30
+#define NOTE_INDEX_FS2 31
+#define NOTE_INDEX_G2 32
+#define NOTE_INDEX_GS2 33
+#define NOTE_INDEX_A2 34
+#define NOTE_INDEX_AS2 35
+#define NOTE_INDEX_B2 36
+#define NOTE_INDEX_C3 37
+#define NOTE_INDEX_CS3 38
+#define NOTE_INDEX_D3 39
+#define NOTE_INDEX_DS3 40
+#define NOTE_INDEX_E3 41
+#define NOTE_INDEX_F3 42
+#define NOTE_INDEX_FS3 43
+#define NOTE_INDEX_G3 44
+#define NOTE_INDEX_GS3 45
+#define NOTE_INDEX_A3 46
+#define NOTE_INDEX_AS3 47
+#define NOTE_INDEX_B3 48
+#define NOTE_INDEX_C4 49
+#define NOTE_INDEX_CS4 50
+#define NOTE_INDEX_D4 51
+#define NOTE_INDEX_DS4 52
+#define NOTE_INDEX_E4 53
+#define NOTE_INDEX_F4 54
+#define NOTE_INDEX_FS4 55
+#define NOTE_INDEX_G4 56
+#define NOTE_INDEX_GS4 57
+#define NOTE_INDEX_A4 58
+#define NOTE_INDEX_AS4 59
+#define NOTE_INDEX_B4 60
+#define NOTE_INDEX_C5 61
+#define NOTE_INDEX_CS5 62
+#define NOTE_INDEX_D5 63
+#define NOTE_INDEX_DS5 64
+#define NOTE_INDEX_E5 65
+#define NOTE_INDEX_F5 66
+#define NOTE_INDEX_FS5 67
+#define NOTE_INDEX_G5 68
+#define NOTE_INDEX_GS5 69
+#define NOTE_INDEX_A5 70
+#define NOTE_INDEX_AS5 71
+#define NOTE_INDEX_B5 72
+#define NOTE_INDEX_C6 73
+#define NOTE_INDEX_CS6 74
+#define NOTE_INDEX_D6 75
+#define NOTE_INDEX_DS6 76
+#define NOTE_INDEX_E6 77
+#define NOTE_INDEX_F6 78
+#define NOTE_INDEX_FS6 79
+#define NOTE_INDEX_G6 80
+#define NOTE_INDEX_GS6 81
+#define NOTE_INDEX_A6 82
+#define NOTE_INDEX_AS6 83
+#define NOTE_INDEX_B6 84
+#define NOTE_INDEX_C7 85
+#define NOTE_INDEX_CS7 86
+#define NOTE_INDEX_D7 87
+#define NOTE_INDEX_DS7 88
+#define NOTE_INDEX_E7 89
+#define NOTE_INDEX_F7 90
+#define NOTE_INDEX_FS7 91
+#define NOTE_INDEX_G7 92
+#define NOTE_INDEX_GS7 93
+#define NOTE_INDEX_A7 94
+#define NOTE_INDEX_AS7 95
+#define NOTE_INDEX_B7 96
+#define NOTE_INDEX_C8 97
+#define NOTE_INDEX_CS8 98
+#define NOTE_INDEX_D8 99
+#define NOTE_INDEX_DS8 100
+#define NOTE_INDEX_E8 101
+#define NOTE_INDEX_F8 102
+#define NOTE_INDEX_FS8 103
+#define NOTE_INDEX_G8 104
+#define NOTE_INDEX_GS8 105
+#define NOTE_INDEX_A8 106
+#define NOTE_INDEX_AS8 107
+#define NOTE_INDEX_B8 108
+
+// Packed Flat Aliases
+#define NOTE_INDEX_DF0 NOTE_INDEX_CS0
+#define NOTE_INDEX_EF0 NOTE_INDEX_DS0
+#define NOTE_INDEX_GF0 NOTE_INDEX_FS0
+#define NOTE_INDEX_AF0 NOTE_INDEX_GS0
+#define NOTE_INDEX_BF0 NOTE_INDEX_AS0
+#define NOTE_INDEX_DF1 NOTE_INDEX_CS1
+#define NOTE_INDEX_EF1 NOTE_INDEX_DS1
+#define NOTE_INDEX_GF1 NOTE_INDEX_FS1
+#define NOTE_INDEX_AF1 NOTE_INDEX_GS1
+#define NOTE_INDEX_BF1 NOTE_INDEX_AS1
+#define NOTE_INDEX_DF2 NOTE_INDEX_CS2
+#define NOTE_INDEX_EF2 NOTE_INDEX_DS2
+#define NOTE_INDEX_GF2 NOTE_INDEX_FS2
+#define NOTE_INDEX_AF2 NOTE_INDEX_GS2
+#define NOTE_INDEX_BF2 NOTE_INDEX_AS2
+#define NOTE_INDEX_DF3 NOTE_INDEX_CS3
+#define NOTE_INDEX_EF3 NOTE_INDEX_DS3
+#define NOTE_INDEX_GF3 NOTE_INDEX_FS3
+#define NOTE_INDEX_AF3 NOTE_INDEX_GS3
+#define NOTE_INDEX_BF3 NOTE_INDEX_AS3
+#define NOTE_INDEX_DF4 NOTE_INDEX_CS4
+#define NOTE_INDEX_EF4 NOTE_INDEX_DS4
+#define NOTE_INDEX_GF4 NOTE_INDEX_FS4
+#define NOTE_INDEX_AF4 NOTE_INDEX_GS4
+#define NOTE_INDEX_BF4 NOTE_INDEX_AS4
+#define NOTE_INDEX_DF5 NOTE_INDEX_CS5
+#define NOTE_INDEX_EF5 NOTE_INDEX_DS5
+#define NOTE_INDEX_GF5 NOTE_INDEX_FS5
+#define NOTE_INDEX_AF5 NOTE_INDEX_GS5
+#define NOTE_INDEX_BF5 NOTE_INDEX_AS5
+#define NOTE_INDEX_DF6 NOTE_INDEX_CS6
+#define NOTE_INDEX_EF6 NOTE_INDEX_DS6
+#define NOTE_INDEX_GF6 NOTE_INDEX_FS6
+#define NOTE_INDEX_AF6 NOTE_INDEX_GS6
+#define NOTE_INDEX_BF6 NOTE_INDEX_AS6
+#define NOTE_INDEX_DF7 NOTE_INDEX_CS7
+#define NOTE_INDEX_EF7 NOTE_INDEX_DS7
+#define NOTE_INDEX_GF7 NOTE_INDEX_FS7
+#define NOTE_INDEX_AF7 NOTE_INDEX_GS7
+#define NOTE_INDEX_BF7 NOTE_INDEX_AS7
+#define NOTE_INDEX_DF8 NOTE_INDEX_CS8
+#define NOTE_INDEX_EF8 NOTE_INDEX_DS8
+#define NOTE_INDEX_GF8 NOTE_INDEX_FS8
+#define NOTE_INDEX_AF8 NOTE_INDEX_GS8
+#define NOTE_INDEX_BF8 NOTE_INDEX_AS8
@@ -0,0 +1,29 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "synth.h"
+
+uint32_t synth_phase_increment(float frequency, float sample_rate) {
+    if (!(frequency > 0.0f)) {
+        return 0;
+    }
+
+    // Above half a period per sample the tone only aliases, and converting the product could overflow a uint32_t
+    float periods_per_sample = frequency / sample_rate;
+    if (periods_per_sample >= 0.5f) {
+        return UINT32_C(0x80000000);
+    }
+
+    return (uint32_t)(periods_per_sample * 4294967296.0f);
+}
+
+uint16_t synth_mix(uint32_t *phase, const uint32_t *increment, uint8_t count, const uint16_t *wavetable, uint8_t shift) {
+    uint_fast32_t value = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        phase[i] += increment[i];
+        value += wavetable[phase[i] >> shift];
+    }
+
+    return value / count;
+}
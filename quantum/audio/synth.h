@@ -0,0 +1,41 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * \defgroup audio_synth Wavetable synthesis
+ *
+ * Hardware agnostic fixed-point oscillators, for audio drivers that compute their output samples.
+ * \{
+ */
+
+/**
+ * \brief Work out the per-sample phase increment of a tone.
+ *
+ * The phase of a tone is a fraction of one period, scaled to the full 32 bits. Frequencies above half the sample rate
+ * are clamped to it, and frequencies of zero or less give an increment of zero.
+ *
+ * \param frequency The frequency of the tone, in Hz.
+ * \param sample_rate The rate at which samples are generated, in Hz.
+ * \return The amount to advance the phase by for every sample.
+ */
+uint32_t synth_phase_increment(float frequency, float sample_rate);
+
+/**
+ * \brief Advance a set of tones by one sample, and mix them.
+ *
+ * \param phase The phases of the tones, updated in place.
+ * \param increment The per-sample phase increments of the tones.
+ * \param count The number of tones. Must not be zero.
+ * \param wavetable One period of the waveform. Its length must be `1 << (32 - shift)`.
+ * \param shift How far to shift a phase right to get the wavetable index.
+ * \return The average of the wavetable samples of all tones.
+ */
+uint16_t synth_mix(uint32_t *phase, const uint32_t *increment, uint8_t count, const uint16_t *wavetable, uint8_t shift);
+
+/** \} */
@@ -0,0 +1,77 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum/audio/synth.h"
+}
+
+// A ramp, so each sample is its own wavetable index
+static uint16_t ramp[256];
+
+class SynthTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        for (int i = 0; i < 256; i++) {
+            ramp[i] = i;
+        }
+    }
+};
+
+TEST_F(SynthTest, PhaseIncrementMatchesFrequency) {
+    // 480 Hz at 48 kHz is exactly 100 samples per period
+    uint32_t increment = synth_phase_increment(480.0f, 48000.0f);
+    EXPECT_NEAR(increment, 4294967296.0 / 100, 4294967296.0 / 100 * 1e-6);
+
+    uint32_t phase = 0;
+    for (int i = 0; i < 100; i++) {
+        phase += increment;
+    }
+    // Back to the start of the period, give or take the rounding of the increment
+    EXPECT_LT((uint32_t)(phase + 1024), 2048u);
+}
+
+TEST_F(SynthTest, PhaseIncrementClampsToHalfTheSampleRate) {
+    EXPECT_EQ(synth_phase_increment(24000.0f, 48000.0f), 0x80000000u);
+    EXPECT_EQ(synth_phase_increment(40000.0f, 48000.0f), 0x80000000u);
+    // Well past the point where the increment no longer fits in 32 bits
+    EXPECT_EQ(synth_phase_increment(1e9f, 48000.0f), 0x80000000u);
+    EXPECT_LT(synth_phase_increment(23999.0f, 48000.0f), 0x80000000u);
+}
+
+TEST_F(SynthTest, PhaseIncrementIsZeroForRests) {
+    EXPECT_EQ(synth_phase_increment(0.0f, 48000.0f), 0u);
+    EXPECT_EQ(synth_phase_increment(-440.0f, 48000.0f), 0u);
+}
+
+TEST_F(SynthTest, MixAdvancesAndWrapsPhases) {
+    uint32_t       phase[]     = {0, 0xFF000000};
+    const uint32_t increment[] = {1 << 24, 2 << 24};
+
+    // One wavetable step for the first tone; the second wraps around from the last entry to index 1
+    EXPECT_EQ(synth_mix(phase, increment, 1, ramp, 24), 1);
+    EXPECT_EQ(phase[0], 1u << 24);
+    EXPECT_EQ(synth_mix(&phase[1], &increment[1], 1, ramp, 24), 1);
+    EXPECT_EQ(phase[1], 1u << 24);
+}
+
+TEST_F(SynthTest, MixAveragesTones) {
+    uint32_t       phase[]     = {0, 100u << 24, 200u << 24};
+    const uint32_t increment[] = {1 << 24, 1 << 24, 1 << 24};
+
+    EXPECT_EQ(synth_mix(phase, increment, 3, ramp, 24), (1 + 101 + 201) / 3);
+    EXPECT_EQ(synth_mix(phase, increment, 3, ramp, 24), (2 + 102 + 202) / 3);
+}
+
+TEST_F(SynthTest, MixHandlesFullScaleSamples) {
+    static const uint16_t full[4] = {4095, 4095, 4095, 4095};
+    uint32_t              phase[8];
+    uint32_t              increment[8];
+    for (int i = 0; i < 8; i++) {
+        phase[i]     = i << 28;
+        increment[i] = synth_phase_increment(440.0f * (i + 1), 72000.0f);
+    }
+
+    EXPECT_EQ(synth_mix(phase, increment, 8, full, 30), 4095);
+}
@@ -22,7 +22,7 @@
 rgb_t hsv_to_rgb_impl(hsv_t hsv, bool use_cie) {
     rgb_t    rgb;
     uint8_t  region, remainder, p, q, t;
-    uint16_t h, s, v;
+    uint16_t h, s, v, h6;
 
     if (hsv.s == 0) {
 #ifdef USE_CIE1931_CURVE
@@ -53,7 +53,11 @@ rgb_t hsv_to_rgb_impl(hsv_t hsv, bool use_cie) {
     v = hsv.v;
 #endif
 
-    region    = h * 6 / 255;
+    // region = h * 6 / 255, using x / 255 == (x + 1 + (x >> 8)) >> 8, which
+    // is exact for the 0..1530 range of h * 6 (the sum stays within a 16-bit
+    // int) and avoids a division libcall on AVR.
+    h6        = h * 6;
+    region    = (h6 + 1 + (h6 >> 8)) >> 8;
     remainder = (h * 2 - region * 85) * 3;
 
     p = (v * (255 - s)) >> 8;
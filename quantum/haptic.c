@@ -33,6 +33,13 @@
 extern uint8_t split_haptic_play;
 #endif
 
+// Effect requested by haptic_play(), played from haptic_task(). Requests made
+// before the next task run, such as a burst of keypresses, are coalesced.
+static bool haptic_play_pending = false;
+#ifdef HAPTIC_DRV2605L
+static uint8_t haptic_play_effect;
+#endif
+
 haptic_config_t haptic_config;
 
 static void update_haptic_enable_gpios(void) {
@@ -104,6 +111,16 @@ void haptic_init(void) {
 }
 
 void haptic_task(void) {
+    if (haptic_play_pending) {
+        haptic_play_pending = false;
+#ifdef HAPTIC_DRV2605L
+        drv2605l_pulse(haptic_play_effect);
+#endif
+#ifdef HAPTIC_SOLENOID
+        solenoid_fire_handler();
+#endif
+    }
+
 #ifdef HAPTIC_SOLENOID
 // Only run task on seconary boards if the user desires
 #    if defined(SPLIT_KEYBOARD) && !defined(SPLIT_HAPTIC_ENABLE)
@@ -331,16 +348,14 @@ void haptic_cont_decrease(void) {
 }
 
 void haptic_play(void) {
+    haptic_play_pending = true;
 #ifdef HAPTIC_DRV2605L
-    uint8_t play_eff = 0;
-    play_eff         = haptic_config.mode;
-    drv2605l_pulse(play_eff);
+    haptic_play_effect = haptic_config.mode;
 #    if defined(SPLIT_KEYBOARD) && defined(SPLIT_HAPTIC_ENABLE)
     split_haptic_play = haptic_config.mode;
 #    endif
 #endif
 #ifdef HAPTIC_SOLENOID
-    solenoid_fire_handler();
 #    if defined(SPLIT_KEYBOARD) && defined(SPLIT_HAPTIC_ENABLE)
     split_haptic_play = 1;
 #    endif
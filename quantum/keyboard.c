@@ -65,6 +65,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef HAPTIC_ENABLE
 #    include "haptic.h"
 #endif
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
 #ifdef AUTO_SHIFT_ENABLE
 #    include "process_auto_shift.h"
 #endif
@@ -74,6 +77,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef TAP_DANCE_ENABLE
 #    include "process_tap_dance.h"
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
 #ifdef STENO_ENABLE
 #    include "process_steno.h"
 #endif
@@ -676,6 +682,10 @@ void quantum_task(void) {
     leader_task();
 #endif
 
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
+#endif
+
 #ifdef WPM_ENABLE
     decay_wpm();
 #endif
@@ -791,6 +801,10 @@ void keyboard_task(void) {
     haptic_task();
 #endif
 
+#ifdef I2C_QUEUE_ENABLE
+    i2c_queue_task();
+#endif
+
     led_task();
 
 #ifdef OS_DETECTION_ENABLE
@@ -136,14 +136,14 @@ __attribute__((weak)) uint16_t tap_dance_count(void) {
 
 STATIC_ASSERT(ARRAY_SIZE(tap_dance_actions) <= (QK_TAP_DANCE_MAX - QK_TAP_DANCE), "Number of tap dance actions exceeds maximum. Are you using SAFE_RANGE in tap dance enum?");
 
-tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx) {
+const tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx) {
     if (tap_dance_idx >= tap_dance_count_raw()) {
         return NULL;
     }
     return &tap_dance_actions[tap_dance_idx];
 }
 
-__attribute__((weak)) tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx) {
+__attribute__((weak)) const tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx) {
     return tap_dance_get_raw(tap_dance_idx);
 }
 
@@ -177,6 +177,34 @@ __attribute__((weak)) const key_override_t* key_override_get(uint16_t key_overri
 
 #endif // defined(KEY_OVERRIDE_ENABLE)
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
+uint16_t leader_sequence_count_raw(void) {
+    return ARRAY_SIZE(leader_sequences);
+}
+
+__attribute__((weak)) uint16_t leader_sequence_count(void) {
+    return leader_sequence_count_raw();
+}
+
+STATIC_ASSERT(ARRAY_SIZE(leader_sequences) <= LEADER_SEQUENCES_MAX, "Number of leader sequences exceeds maximum set by LEADER_SEQUENCES_MAX");
+
+leader_sequence_t* leader_sequence_get_raw(uint16_t leader_sequence_idx) {
+    if (leader_sequence_idx >= leader_sequence_count_raw()) {
+        return NULL;
+    }
+    return &leader_sequences[leader_sequence_idx];
+}
+
+__attribute__((weak)) leader_sequence_t* leader_sequence_get(uint16_t leader_sequence_idx) {
+    return leader_sequence_get_raw(leader_sequence_idx);
+}
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Community modules (must be last in this file!)
 
@@ -83,9 +83,9 @@ uint16_t tap_dance_count_raw(void);
 uint16_t tap_dance_count(void);
 
 // Get the tap dance definitions, stored in firmware rather than any other persistent storage
-tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx);
+const tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx);
 // Get the tap dance definitions, potentially stored dynamically
-tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx);
+const tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx);
 
 #endif // defined(TAP_DANCE_ENABLE)
 
@@ -109,3 +109,24 @@ const key_override_t* key_override_get_raw(uint16_t key_override_idx);
 const key_override_t* key_override_get(uint16_t key_override_idx);
 
 #endif // defined(KEY_OVERRIDE_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
+// Forward declaration of leader_sequence_t so we don't need to deal with header reordering
+struct leader_sequence_t;
+typedef struct leader_sequence_t leader_sequence_t;
+
+// Get the number of leader sequences defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint16_t leader_sequence_count_raw(void);
+// Get the number of leader sequences defined in the user's keymap, potentially stored dynamically
+uint16_t leader_sequence_count(void);
+
+// Get the leader sequence definition, stored in firmware rather than any other persistent storage
+leader_sequence_t* leader_sequence_get_raw(uint16_t leader_sequence_idx);
+// Get the leader sequence definition, potentially stored dynamically
+leader_sequence_t* leader_sequence_get(uint16_t leader_sequence_idx);
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
@@ -7,6 +7,12 @@
 
 #include <string.h>
 
+#if defined(LEADER_SEQUENCES_ENABLE)
+#    include "keymap_introspection.h"
+#    include "progmem.h"
+#    include "quantum.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
@@ -17,6 +23,89 @@ uint16_t leader_time          = 0;
 uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
 uint8_t  leader_sequence_size = 0;
 
+#if defined(LEADER_SEQUENCES_ENABLE)
+// Entries of the leader_sequences table that still match the keys typed so far
+static uint8_t            leader_candidates[(LEADER_SEQUENCES_MAX + 7) / 8];
+static uint16_t           leader_candidate_count = 0;
+static uint8_t            leader_sequence_depth  = 0;
+static leader_sequence_t *leader_match           = NULL;
+
+static uint16_t leader_sequences_size(void) {
+    return MIN(leader_sequence_count(), LEADER_SEQUENCES_MAX);
+}
+
+static void leader_sequences_reset(void) {
+    uint16_t count = leader_sequences_size();
+
+    memset(leader_candidates, 0, sizeof(leader_candidates));
+    memset(leader_candidates, 0xFF, count / 8);
+    if (count % 8) {
+        leader_candidates[count / 8] = (1 << (count % 8)) - 1;
+    }
+    leader_candidate_count = count;
+    leader_sequence_depth  = 0;
+    leader_match           = NULL;
+}
+
+/**
+ * \brief Drop the candidates that do not continue with the given keycode.
+ *
+ * Only entries that matched the previous keys are looked at, so each key costs less as the sequence goes on.
+ *
+ * \return `true` if exactly one complete entry is left, and nothing longer could still match.
+ */
+static bool leader_sequences_narrow(uint16_t keycode) {
+    uint16_t count      = leader_sequences_size();
+    bool     extendable = false;
+
+    leader_match = NULL;
+    if (keycode == LEADER_SEQUENCE_END || leader_sequence_depth == UINT8_MAX) {
+        memset(leader_candidates, 0, sizeof(leader_candidates));
+        leader_candidate_count = 0;
+        return false;
+    }
+
+    for (uint16_t i = 0; i < count && leader_candidate_count; i++) {
+        if (!leader_candidates[i / 8]) {
+            i |= 7;
+            continue;
+        }
+        if (!(leader_candidates[i / 8] & (1 << (i % 8)))) {
+            continue;
+        }
+
+        leader_sequence_t *sequence = leader_sequence_get(i);
+        if (pgm_read_word(&sequence->keys[leader_sequence_depth]) != keycode) {
+            leader_candidates[i / 8] &= ~(1 << (i % 8));
+            leader_candidate_count--;
+        } else if (pgm_read_word(&sequence->keys[leader_sequence_depth + 1]) == LEADER_SEQUENCE_END) {
+            if (leader_match == NULL) {
+                leader_match = sequence;
+            }
+        } else {
+            extendable = true;
+        }
+    }
+    leader_sequence_depth++;
+
+    return leader_match != NULL && !extendable;
+}
+
+static void leader_sequences_fire(void) {
+    leader_sequence_t *sequence = leader_match;
+
+    leader_match = NULL;
+    if (sequence == NULL) {
+        return;
+    }
+    if (sequence->action) {
+        sequence->action();
+    } else if (sequence->keycode) {
+        tap_code16(sequence->keycode);
+    }
+}
+#endif
+
 __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
@@ -34,10 +123,16 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#if defined(LEADER_SEQUENCES_ENABLE)
+    leader_sequences_reset();
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#if defined(LEADER_SEQUENCES_ENABLE)
+    leader_sequences_fire();
+#endif
     leader_end_user();
 }
 
@@ -51,8 +146,17 @@ bool leader_sequence_active(void) {
     return leading;
 }
 
+static bool leader_sequence_full(void) {
+#if defined(LEADER_SEQUENCES_ENABLE)
+    if (leader_candidate_count) {
+        return false;
+    }
+#endif
+    return leader_sequence_size >= ARRAY_SIZE(leader_sequence);
+}
+
 bool leader_sequence_add(uint16_t keycode) {
-    if (leader_sequence_size >= ARRAY_SIZE(leader_sequence)) {
+    if (leader_sequence_full()) {
         return false;
     }
 
@@ -62,10 +166,17 @@ bool leader_sequence_add(uint16_t keycode) {
     }
 #endif
 
-    leader_sequence[leader_sequence_size] = keycode;
-    leader_sequence_size++;
+    if (leader_sequence_size < ARRAY_SIZE(leader_sequence)) {
+        leader_sequence[leader_sequence_size] = keycode;
+        leader_sequence_size++;
+    }
+
+    bool resolved = false;
+#if defined(LEADER_SEQUENCES_ENABLE)
+    resolved = leader_sequences_narrow(keycode);
+#endif
 
-    if (leader_add_user(keycode)) {
+    if (leader_add_user(keycode) || resolved) {
         leader_end();
     }
     return true;
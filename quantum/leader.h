@@ -1,6 +1,8 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -11,6 +13,33 @@
  * \{
  */
 
+#if defined(LEADER_SEQUENCES_ENABLE)
+
+#    ifndef LEADER_SEQUENCES_MAX
+#        define LEADER_SEQUENCES_MAX 64
+#    endif
+
+/**
+ * \brief An entry in the `leader_sequences` table.
+ *
+ * `keys` points to a `LEADER_SEQUENCE_END` terminated array of keycodes. When the sequence is typed, `action` is
+ * called if it is set, otherwise `keycode` is tapped.
+ */
+typedef struct leader_sequence_t {
+    const uint16_t *keys;
+    uint16_t        keycode;
+    void (*action)(void);
+} leader_sequence_t;
+
+#    define LEADER_SEQUENCE(ls, kc) \
+        { .keys = &(ls)[0], .keycode = (kc) }
+#    define LEADER_SEQUENCE_ACTION(ls, fn) \
+        { .keys = &(ls)[0], .action = (fn) }
+
+#    define LEADER_SEQUENCE_END 0
+
+#endif // defined(LEADER_SEQUENCES_ENABLE)
+
 /**
  * \brief User callback, invoked when the leader sequence begins.
  */
@@ -52,6 +81,10 @@ bool leader_sequence_active(void);
  *
  * If `LEADER_NO_TIMEOUT` is defined, the timer is reset if the buffer is empty.
  *
+ * If `LEADER_SEQUENCES_ENABLE` is set, the `leader_sequences` table is narrowed down to the entries that still
+ * match, and the leader sequence ends as soon as only one complete entry is left. Keys past the end of the buffer
+ * are still accepted while some entry can match them.
+ *
  * \param keycode The keycode to add.
  *
  * \return `true` if the keycode was added, `false` if the buffer is full.
@@ -23,6 +23,7 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "render_budget.h"
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -77,6 +78,14 @@ static uint8_t         led_last_effect   = UINT8_MAX;
 static effect_params_t led_effect_params = {0, LED_FLAG_ALL, false};
 static led_task_states led_task_state    = SYNCING;
 
+#ifdef LED_MATRIX_RENDER_BUDGET
+// adaptive render slicing
+static render_budget_t led_render_budget = RENDER_BUDGET_INIT(LED_MATRIX_LED_PROCESS_LIMIT);
+#    define LED_MATRIX_SLICE_SIZE led_render_budget.process_limit
+#elif defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
+#    define LED_MATRIX_SLICE_SIZE LED_MATRIX_LED_PROCESS_LIMIT
+#endif
+
 // double buffers
 static uint32_t led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
@@ -255,6 +264,11 @@ static void led_task_start(void) {
     // reset iter
     led_effect_params.iter = 0;
 
+#ifdef LED_MATRIX_RENDER_BUDGET
+    // resize the slices between frames, so that every slice of a frame has the same size
+    render_budget_adapt(&led_render_budget, LED_MATRIX_RENDER_BUDGET, LED_MATRIX_LED_COUNT);
+#endif
+
     // update double buffers
     g_led_timer = led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
@@ -335,12 +349,19 @@ static void led_task_flush(uint8_t effect) {
     // update pwm buffers
     led_matrix_update_pwm_buffers();
 
+#ifdef LED_MATRIX_RENDER_BUDGET
+    render_budget_frame(&led_render_budget);
+#endif
+
     // next task
     led_task_state = SYNCING;
 }
 
 void led_matrix_task(void) {
     led_task_timers();
+#ifdef LED_MATRIX_RENDER_BUDGET
+    render_budget_stats(&led_render_budget);
+#endif
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
@@ -356,7 +377,12 @@ void led_matrix_task(void) {
         case STARTING:
             led_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef LED_MATRIX_RENDER_BUDGET
+            // yield to the matrix scan for the rest of the millisecond in which a key changed
+            if (last_matrix_activity_elapsed() == 0) break;
+            uint32_t render_start = timer_read32();
+#endif
             led_task_render(effect);
             if (effect) {
                 if (led_task_state == FLUSHING) {
@@ -364,7 +390,10 @@ void led_matrix_task(void) {
                 }
                 led_matrix_indicators_advanced(&led_effect_params);
             }
-            break;
+#ifdef LED_MATRIX_RENDER_BUDGET
+            render_budget_account(&led_render_budget, timer_elapsed32(render_start));
+#endif
+        } break;
         case FLUSHING:
             led_task_flush(effect);
             break;
@@ -416,16 +445,16 @@ __attribute__((weak)) bool led_matrix_indicators_advanced_user(uint8_t led_min,
 
 struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
     struct led_matrix_limits_t limits = {0};
-#if defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
+#if defined(LED_MATRIX_SLICE_SIZE)
 #    if defined(LED_MATRIX_SPLIT)
-    limits.led_min_index = LED_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + LED_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = LED_MATRIX_SLICE_SIZE * (iter);
+    limits.led_max_index = limits.led_min_index + LED_MATRIX_SLICE_SIZE;
     if (limits.led_max_index > LED_MATRIX_LED_COUNT) limits.led_max_index = LED_MATRIX_LED_COUNT;
     if (is_keyboard_left() && (limits.led_max_index > k_led_matrix_split[0])) limits.led_max_index = k_led_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_led_matrix_split[0])) limits.led_min_index = k_led_matrix_split[0];
 #    else
-    limits.led_min_index = LED_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + LED_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = LED_MATRIX_SLICE_SIZE * (iter);
+    limits.led_max_index = limits.led_min_index + LED_MATRIX_SLICE_SIZE;
     if (limits.led_max_index > LED_MATRIX_LED_COUNT) limits.led_max_index = LED_MATRIX_LED_COUNT;
 #    endif
 #else
@@ -479,6 +508,20 @@ bool led_matrix_get_suspend_state(void) {
     return suspend_state;
 }
 
+#ifdef LED_MATRIX_RENDER_BUDGET
+uint16_t led_matrix_get_frame_rate(void) {
+    return led_render_budget.frame_rate;
+}
+
+uint16_t led_matrix_get_render_load(void) {
+    return led_render_budget.render_load;
+}
+
+uint8_t led_matrix_get_process_limit(void) {
+    return led_render_budget.process_limit;
+}
+#endif
+
 void led_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     led_matrix_eeconfig.enable ^= 1;
     led_task_state = STARTING;
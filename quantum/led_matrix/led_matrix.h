@@ -184,6 +184,12 @@ led_flags_t led_matrix_get_flags(void);
 void        led_matrix_set_flags(led_flags_t flags);
 void        led_matrix_set_flags_noeeprom(led_flags_t flags);
 
+#ifdef LED_MATRIX_RENDER_BUDGET
+uint16_t led_matrix_get_frame_rate(void);
+uint16_t led_matrix_get_render_load(void);
+uint8_t  led_matrix_get_process_limit(void);
+#endif
+
 #ifdef LED_MATRIX_MODE_NAME_ENABLE
 const char *led_matrix_get_mode_name(uint8_t mode);
 #endif // LED_MATRIX_MODE_NAME_ENABLE
@@ -168,6 +168,34 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
+#            ifdef MATRIX_READ_COLS_BY_PORT
+// Column pins grouped by GPIO port, so every port is sampled with a single
+// register read per row instead of one read per column.
+static pin_t       col_port_pins[MATRIX_COLS]; // one pin of each distinct port
+static uint8_t     col_port_count;
+static uint8_t     col_port_index[MATRIX_COLS];
+static port_data_t col_pin_masks[MATRIX_COLS];
+
+static void matrix_init_col_ports(void) {
+    col_port_count = 0;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pin_t pin = col_pins[col];
+        if (pin == NO_PIN) {
+            continue;
+        }
+        uint8_t port = 0;
+        while (port < col_port_count && !gpio_same_port(col_port_pins[port], pin)) {
+            port++;
+        }
+        if (port == col_port_count) {
+            col_port_pins[col_port_count++] = pin;
+        }
+        col_port_index[col] = port;
+        col_pin_masks[col]  = gpio_pin_mask(pin);
+    }
+}
+#            endif
+
 __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
@@ -177,6 +205,25 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_COLS_BY_PORT
+    // Sample every port at once...
+    port_data_t port_state[MATRIX_COLS];
+    for (uint8_t port = 0; port < col_port_count; port++) {
+        port_state[port] = gpio_read_port(col_port_pins[port]);
+    }
+
+    // ...then pick out each col
+    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+    for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
+        if (col_pins[col_index] == NO_PIN) {
+            continue;
+        }
+        bool pin_level = (port_state[col_port_index[col_index]] & col_pin_masks[col_index]) != 0;
+
+        // Populate the matrix row with the state of the col pin
+        current_row_value |= (pin_level == MATRIX_INPUT_PRESSED_STATE) ? row_shifter : 0;
+    }
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -185,6 +232,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -298,6 +346,9 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#if defined(MATRIX_READ_COLS_BY_PORT) && !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+    matrix_init_col_ports();
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
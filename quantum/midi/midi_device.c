@@ -81,10 +81,12 @@ void midi_device_process(MidiDevice* device) {
     uint16_t         i;
     // TODO limit number of bytes processed?
     for (i = 0; i < len; i++) {
-        uint8_t val = bytequeue_get(&device->input_queue, 0);
+        uint8_t val = bytequeue_get(&device->input_queue, i);
         midi_process_byte(device, val);
-        bytequeue_remove(&device->input_queue, 1);
     }
+    // there is only one reader, so the processed bytes can be released in one go
+    // rather than taking the queue lock once per byte
+    if (len) bytequeue_remove(&device->input_queue, len);
 }
 
 void midi_process_byte(MidiDevice* device, uint8_t input) {
@@ -0,0 +1,150 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum/midi/midi.h"
+#include "quantum/midi/bytequeue/interrupt_setting.h"
+}
+
+struct midi_event_t {
+    uint8_t status;
+    uint8_t data1;
+    uint8_t data2;
+
+    bool operator==(const midi_event_t &other) const {
+        return status == other.status && data1 == other.data1 && data2 == other.data2;
+    }
+};
+
+static std::vector<midi_event_t> received;
+static uint16_t                  lock_count;
+static MidiDevice                sender;
+static MidiDevice                receiver;
+
+extern "C" {
+interrupt_setting_t store_and_clear_interrupt(void) {
+    lock_count++;
+    return 0;
+}
+
+void restore_interrupt_setting(interrupt_setting_t setting) {}
+}
+
+static void on_cc(MidiDevice *device, uint8_t chan, uint8_t num, uint8_t val) {
+    received.push_back({(uint8_t)(MIDI_CC | chan), num, val});
+}
+
+static void on_noteon(MidiDevice *device, uint8_t chan, uint8_t note, uint8_t vel) {
+    received.push_back({(uint8_t)(MIDI_NOTEON | chan), note, vel});
+}
+
+static void on_noteoff(MidiDevice *device, uint8_t chan, uint8_t note, uint8_t vel) {
+    received.push_back({(uint8_t)(MIDI_NOTEOFF | chan), note, vel});
+}
+
+// Bytes sent through one device come straight back in on the other
+static void loopback(MidiDevice *device, uint16_t count, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    uint8_t bytes[] = {byte0, byte1, byte2};
+    midi_device_input(&receiver, count, bytes);
+}
+
+class MidiTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        received.clear();
+        midi_device_init(&sender);
+        midi_device_set_send_func(&sender, loopback);
+        midi_device_init(&receiver);
+        midi_register_cc_callback(&receiver, on_cc);
+        midi_register_noteon_callback(&receiver, on_noteon);
+        midi_register_noteoff_callback(&receiver, on_noteoff);
+    }
+
+    void input(std::vector<uint8_t> bytes) {
+        midi_device_input(&receiver, bytes.size(), bytes.data());
+    }
+};
+
+TEST_F(MidiTest, LoopsBackSentMessages) {
+    midi_send_noteon(&sender, 0, 60, 100);
+    midi_send_cc(&sender, 2, 7, 127);
+    midi_send_noteoff(&sender, 0, 60, 0);
+    midi_device_process(&receiver);
+
+    std::vector<midi_event_t> expected = {{MIDI_NOTEON, 60, 100}, {MIDI_CC | 2, 7, 127}, {MIDI_NOTEOFF, 60, 0}};
+    EXPECT_EQ(received, expected);
+}
+
+TEST_F(MidiTest, DecodesRunningStatus) {
+    input({MIDI_CC | 1, 1, 10, 1, 20, 1, 30, MIDI_NOTEON | 3, 60, 100, 64, 90});
+    midi_device_process(&receiver);
+
+    std::vector<midi_event_t> expected = {
+        {MIDI_CC | 1, 1, 10}, {MIDI_CC | 1, 1, 20}, {MIDI_CC | 1, 1, 30}, {MIDI_NOTEON | 3, 60, 100}, {MIDI_NOTEON | 3, 64, 90},
+    };
+    EXPECT_EQ(received, expected);
+}
+
+TEST_F(MidiTest, KeepsRunningStatusAcrossProcessCalls) {
+    input({MIDI_CC, 1, 10, 1});
+    midi_device_process(&receiver);
+    EXPECT_EQ(bytequeue_length(&receiver.input_queue), 0);
+    input({20});
+    midi_device_process(&receiver);
+
+    std::vector<midi_event_t> expected = {{MIDI_CC, 1, 10}, {MIDI_CC, 1, 20}};
+    EXPECT_EQ(received, expected);
+}
+
+TEST_F(MidiTest, RemovesProcessedBytesWithOneLock) {
+    input({MIDI_CC, 1, 10, 1, 20, 1, 30, 1, 40});
+
+    lock_count = 0;
+    midi_device_process(&receiver);
+    // One lock to read the queue length, and one to release all of the processed bytes
+    EXPECT_EQ(lock_count, 2);
+    EXPECT_EQ(received.size(), 4u);
+    EXPECT_EQ(bytequeue_length(&receiver.input_queue), 0);
+}
+
+TEST_F(MidiTest, ProcessesAcrossQueueWrapAround) {
+    // Enough rounds to go around the input queue several times
+    for (uint8_t round = 0; round < 100; round++) {
+        received.clear();
+        for (uint8_t i = 0; i < 3; i++) {
+            midi_send_cc(&sender, 0, i, round & 0x7F);
+        }
+        midi_device_process(&receiver);
+
+        std::vector<midi_event_t> expected = {{MIDI_CC, 0, (uint8_t)(round & 0x7F)}, {MIDI_CC, 1, (uint8_t)(round & 0x7F)}, {MIDI_CC, 2, (uint8_t)(round & 0x7F)}};
+        ASSERT_EQ(received, expected) << "round " << (int)round;
+        ASSERT_EQ(bytequeue_length(&receiver.input_queue), 0);
+    }
+}
+
+static void echo_noteon(MidiDevice *device, uint8_t chan, uint8_t note, uint8_t vel) {
+    on_noteon(device, chan, note, vel);
+    if (note < 62) {
+        midi_send_noteon(&sender, chan, note + 1, vel);
+    }
+}
+
+TEST_F(MidiTest, KeepsBytesQueuedWhileProcessing) {
+    // Messages queued by a callback are past the processed length, and must survive the batched remove
+    midi_register_noteon_callback(&receiver, echo_noteon);
+    midi_send_noteon(&sender, 0, 60, 100);
+
+    midi_device_process(&receiver);
+    EXPECT_EQ(received.size(), 1u);
+    EXPECT_EQ(bytequeue_length(&receiver.input_queue), 3);
+
+    midi_device_process(&receiver);
+    midi_device_process(&receiver);
+    std::vector<midi_event_t> expected = {{MIDI_NOTEON, 60, 100}, {MIDI_NOTEON, 61, 100}, {MIDI_NOTEON, 62, 100}};
+    EXPECT_EQ(received, expected);
+    EXPECT_EQ(bytequeue_length(&receiver.input_queue), 0);
+}
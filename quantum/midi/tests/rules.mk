@@ -0,0 +1,5 @@
+midi_SRC := \
+	$(QUANTUM_PATH)/midi/tests/midi_tests.cpp \
+	$(QUANTUM_PATH)/midi/midi.c \
+	$(QUANTUM_PATH)/midi/midi_device.c \
+	$(QUANTUM_PATH)/midi/bytequeue/bytequeue.c
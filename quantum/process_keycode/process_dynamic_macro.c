@@ -18,9 +18,11 @@
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
 #include <stddef.h>
+#include <string.h>
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "timer.h"
 #include "wait.h"
 
 #ifdef BACKLIGHT_ENABLE
@@ -82,166 +84,415 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
+/* Both macros share one byte buffer but read/write on different ends
+ * of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer. Its bytes are stored back to front, so that both macros
+ * read as the same kind of byte stream.
+ *
+ * macro_buffer[0]     macro_length[0]
+ *  v                   v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *                           ^                                 ^
+ *                    macro_length[1]           macro_buffer[SIZE - 1]
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * Each event is packed as a flags byte, the key position, the tap
+ * state and keycode only when they are set, and the time since the
+ * previous event as a little-endian base-128 varint.
+ */
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+
+/* The length of each macro, in bytes. */
+static uint16_t macro_length[2] = {0, 0};
+
+#define DYNAMIC_MACRO_EVENT_PRESSED 0x80
+#define DYNAMIC_MACRO_EVENT_TYPE_SHIFT 4
+#define DYNAMIC_MACRO_EVENT_TYPE_MASK 0x07
+#define DYNAMIC_MACRO_EVENT_HAS_TAP 0x08
+#define DYNAMIC_MACRO_EVENT_HAS_KEYCODE 0x04
+#define DYNAMIC_MACRO_EVENT_MAX_SIZE 9
+
 /* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+ * need a `slot` variable accessible at the call site.
  */
-#define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+#define DYNAMIC_MACRO_CURRENT_SLOT() (slot + 1)
+#define DYNAMIC_MACRO_DIRECTION() (slot ? -1 : +1)
+
+static inline uint8_t dynamic_macro_read(uint8_t slot, uint16_t index) {
+    return macro_buffer[slot ? DYNAMIC_MACRO_BUFFER_SIZE - 1 - index : index];
+}
+
+static inline void dynamic_macro_write(uint8_t slot, uint16_t index, uint8_t data) {
+    macro_buffer[slot ? DYNAMIC_MACRO_BUFFER_SIZE - 1 - index : index] = data;
+}
 
 /**
- * Start recording of the dynamic macro.
+ * Pack a key record.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param[out] data   At least DYNAMIC_MACRO_EVENT_MAX_SIZE bytes.
+ * @param[in]  record The record to pack.
+ * @param[in]  delta  Milliseconds since the previous event.
+ * @return The number of bytes used.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
-    dprintln("dynamic macro recording: started");
-
-    dynamic_macro_record_start_kb(direction);
+static uint8_t dynamic_macro_encode(uint8_t *data, keyrecord_t *record, uint16_t delta) {
+    uint8_t length = 1;
+    uint8_t flags  = (record->event.pressed ? DYNAMIC_MACRO_EVENT_PRESSED : 0) | ((record->event.type & DYNAMIC_MACRO_EVENT_TYPE_MASK) << DYNAMIC_MACRO_EVENT_TYPE_SHIFT);
+
+    data[length++] = record->event.key.row;
+    data[length++] = record->event.key.col;
+#ifndef NO_ACTION_TAPPING
+    uint8_t tap;
+    memcpy(&tap, &record->tap, sizeof(tap));
+    if (tap) {
+        flags |= DYNAMIC_MACRO_EVENT_HAS_TAP;
+        data[length++] = tap;
+    }
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (record->keycode) {
+        flags |= DYNAMIC_MACRO_EVENT_HAS_KEYCODE;
+        data[length++] = record->keycode & 0xFF;
+        data[length++] = record->keycode >> 8;
+    }
+#endif
+    do {
+        data[length++] = (delta & 0x7F) | (delta > 0x7F ? 0x80 : 0);
+        delta >>= 7;
+    } while (delta);
 
-    clear_keyboard();
-    layer_clear();
-    *macro_pointer = macro_buffer;
+    data[0] = flags;
+    return length;
 }
 
 /**
- * Play the dynamic macro.
+ * Unpack the key record starting at the given position of a macro.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param[in]  slot   The macro to read from.
+ * @param[in]  index  The position of the record.
+ * @param[out] record The unpacked record. Its time is left untouched.
+ * @param[out] delta  Milliseconds since the previous event.
+ * @return The position of the next record.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
-    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
+static uint16_t dynamic_macro_decode(uint8_t slot, uint16_t index, keyrecord_t *record, uint16_t *delta) {
+    uint8_t flags = dynamic_macro_read(slot, index++);
+
+    record->event.pressed = flags & DYNAMIC_MACRO_EVENT_PRESSED;
+    record->event.type    = (flags >> DYNAMIC_MACRO_EVENT_TYPE_SHIFT) & DYNAMIC_MACRO_EVENT_TYPE_MASK;
+    record->event.key.row = dynamic_macro_read(slot, index++);
+    record->event.key.col = dynamic_macro_read(slot, index++);
+    if (flags & DYNAMIC_MACRO_EVENT_HAS_TAP) {
+        uint8_t tap = dynamic_macro_read(slot, index++);
+#ifndef NO_ACTION_TAPPING
+        memcpy(&record->tap, &tap, sizeof(tap));
+#else
+        (void)tap;
+#endif
+    }
+    if (flags & DYNAMIC_MACRO_EVENT_HAS_KEYCODE) {
+        uint16_t keycode = dynamic_macro_read(slot, index++);
+        keycode |= dynamic_macro_read(slot, index++) << 8;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record->keycode = keycode;
+#else
+        (void)keycode;
+#endif
+    }
+    uint8_t shift = 0;
+    uint8_t data;
+    *delta = 0;
+    do {
+        data = dynamic_macro_read(slot, index++);
+        *delta |= (uint16_t)(data & 0x7F) << shift;
+        shift += 7;
+    } while (data & 0x80);
+
+    return index;
+}
 
-    layer_state_t saved_layer_state = layer_state;
+/* Recording state */
 
-    clear_keyboard();
-    layer_clear();
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
-    }
+/* The length recorded so far, and the time of the last recorded event. */
+static uint16_t record_length    = 0;
+static uint16_t record_last_time = 0;
 
-    clear_keyboard();
+/* Set once an event did not fit. Every later event is dropped too, so
+ * that a smaller key-up cannot be kept after its key-down was lost or
+ * the other way around. */
+static bool record_full = false;
 
-    layer_state_set(saved_layer_state);
+/**
+ * Start recording of the dynamic macro.
+ *
+ * @param[in] slot The macro to record, 0 or 1.
+ */
+static void dynamic_macro_record_start(uint8_t slot) {
+    dprintln("dynamic macro recording: started");
 
-    dynamic_macro_play_kb(direction);
+    dynamic_macro_record_start_kb(DYNAMIC_MACRO_DIRECTION());
+
+    clear_keyboard();
+    layer_clear();
+    record_length = 0;
+    record_full   = false;
 }
 
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
- * @param record[in]     The current keypress.
+ * @param[in] slot   The macro being recorded, 0 or 1.
+ * @param[in] record The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+static void dynamic_macro_record_key(uint8_t slot, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && record_length == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
+    uint8_t  data[DYNAMIC_MACRO_EVENT_MAX_SIZE];
+    uint16_t delta  = record_length ? TIMER_DIFF_16(record->event.time, record_last_time) : 0;
+    uint8_t  length = dynamic_macro_encode(data, record, delta);
+
     /* The other end of the other macro is the last buffer element it
      * is safe to use before overwriting the other macro.
      */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    if (record_full || record_length + length + macro_length[!slot] > DYNAMIC_MACRO_BUFFER_SIZE) {
+        record_full = true;
+    } else {
+        for (uint8_t i = 0; i < length; i++) {
+            dynamic_macro_write(slot, record_length + i, data[i]);
+        }
+        record_length += length;
+        record_last_time = record->event.time;
     }
-    dynamic_macro_record_key_kb(direction, record);
+    dynamic_macro_record_key_kb(DYNAMIC_MACRO_DIRECTION(), record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), record_length, DYNAMIC_MACRO_BUFFER_SIZE - macro_length[!slot]);
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * length of the macro.
+ *
+ * @param[in] slot The macro being recorded, 0 or 1.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
-    dynamic_macro_record_end_kb(direction);
+static void dynamic_macro_record_end(uint8_t slot) {
+    dynamic_macro_record_end_kb(DYNAMIC_MACRO_DIRECTION());
 
     /* Do not save the keys being held when stopping the recording,
-     * i.e. the keys used to access the layer DM_RSTP is on.
+     * i.e. the keys used to access the layer DM_RSTP is on. Records can
+     * only be walked forwards, so cut after the last key-up event.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    uint16_t    length = 0;
+    uint16_t    delta;
+    keyrecord_t record = {0};
+    for (uint16_t index = 0; index < record_length;) {
+        index = dynamic_macro_decode(slot, index, &record, &delta);
+        if (!record.event.pressed) {
+            length = index;
+        }
+    }
+    if (length != record_length) {
+        dprintln("dynamic macro: trimming trailing key-down events");
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), length);
 
-    *macro_end = macro_pointer;
+    macro_length[slot] = length;
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
+/**
+ * If a dynamic macro is currently being recorded, stop recording.
  */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+void dynamic_macro_stop_recording(void) {
+    if (macro_id) {
+        dynamic_macro_record_end(macro_id - 1);
+    }
+    macro_id = 0;
+}
 
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
+/* A key the macro being played has pressed and not released yet. */
+typedef struct {
+    keypos_t key;
+    uint8_t  type;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    uint16_t keycode;
+#endif
+} dynamic_macro_held_t;
 
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+/* Playback state. A macro may play the other one, so there is room
+ * for both; a macro that would end up playing itself is ignored.
+ */
+typedef struct {
+    dynamic_macro_held_t held[DYNAMIC_MACRO_HELD_KEYS];
+    uint8_t              held_count;
+    bool                 held_overflow;
+
+    layer_state_t saved_layer_state;
+    uint16_t      index;
+    uint16_t      length;
+    uint16_t      time; /* time of the last event, on the recorded timeline */
+#if defined(DYNAMIC_MACRO_DELAY) && !defined(DYNAMIC_MACRO_KEEP_TIMING)
+    uint16_t last_played;
+#endif
+    uint8_t slot;
+} dynamic_macro_playback_t;
+
+static dynamic_macro_playback_t playback[2];
+static uint8_t                  playback_depth = 0;
+
+/**
+ * Start playing the dynamic macro. The events are replayed from
+ * dynamic_macro_task(), so the matrix keeps being scanned meanwhile.
+ *
+ * @param[in] slot The macro to play, 0 or 1.
+ */
+static void dynamic_macro_play(uint8_t slot) {
+    for (uint8_t i = 0; i < playback_depth; i++) {
+        if (playback[i].slot == slot) {
+            dprintf("dynamic macro: slot %d is already playing, ignoring\n", DYNAMIC_MACRO_CURRENT_SLOT());
+            return;
+        }
+    }
 
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+    dynamic_macro_playback_t *state = &playback[playback_depth++];
+
+    state->saved_layer_state = layer_state;
+    state->slot              = slot;
+    state->index             = 0;
+    state->length            = macro_length[slot];
+    state->held_count        = 0;
+    state->held_overflow     = false;
+    state->time              = timer_read();
+#if defined(DYNAMIC_MACRO_DELAY) && !defined(DYNAMIC_MACRO_KEEP_TIMING)
+    state->last_played = state->time - DYNAMIC_MACRO_DELAY;
+#endif
 
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
+    clear_keyboard();
+    layer_clear();
+}
 
 /**
- * If a dynamic macro is currently being recorded, stop recording.
+ * Keep track of the keys the macro holds down, so that only those are
+ * released when it ends and not the ones the user is holding.
  */
-void dynamic_macro_stop_recording(void) {
-    switch (macro_id) {
-        case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
-            break;
-        case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
-            break;
+static void dynamic_macro_play_track(dynamic_macro_playback_t *state, keyrecord_t *record) {
+    for (uint8_t i = 0; i < state->held_count; i++) {
+        dynamic_macro_held_t *held = &state->held[i];
+        if (KEYEQ(held->key, record->event.key) && held->type == record->event.type) {
+            if (!record->event.pressed) {
+                *held = state->held[--state->held_count];
+            }
+            return;
+        }
     }
-    macro_id = 0;
+
+    if (!record->event.pressed) {
+        return;
+    }
+    if (state->held_count == DYNAMIC_MACRO_HELD_KEYS) {
+        state->held_overflow = true;
+        return;
+    }
+
+    dynamic_macro_held_t *held = &state->held[state->held_count++];
+
+    held->key  = record->event.key;
+    held->type = record->event.type;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    held->keycode = record->keycode;
+#endif
+}
+
+static void dynamic_macro_play_end(void) {
+    dynamic_macro_playback_t *state = &playback[--playback_depth];
+    uint8_t                   slot  = state->slot;
+
+    if (state->held_overflow) {
+        /* Lost track of what the macro holds, release everything. */
+        clear_keyboard();
+    } else {
+        while (state->held_count) {
+            dynamic_macro_held_t *held   = &state->held[--state->held_count];
+            keyrecord_t           record = {0};
+
+            record.event = MAKE_EVENT(held->key.row, held->key.col, false, held->type);
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+            record.keycode = held->keycode;
+#endif
+            process_record(&record);
+        }
+    }
+
+    layer_state_set(state->saved_layer_state);
+
+    dynamic_macro_play_kb(DYNAMIC_MACRO_DIRECTION());
+}
+
+bool dynamic_macro_is_playing(void) {
+    return playback_depth > 0;
+}
+
+void dynamic_macro_task(void) {
+    if (!playback_depth) {
+        return;
+    }
+
+    dynamic_macro_playback_t *state = &playback[playback_depth - 1];
+
+    if (state->index < state->length) {
+        keyrecord_t record = {0};
+        uint16_t    delta;
+        uint16_t    next = dynamic_macro_decode(state->slot, state->index, &record, &delta);
+
+#ifdef DYNAMIC_MACRO_KEEP_TIMING
+        if (!timer_expired(timer_read(), state->time + delta)) {
+            return;
+        }
+#elif defined(DYNAMIC_MACRO_DELAY)
+        if (timer_elapsed(state->last_played) < DYNAMIC_MACRO_DELAY) {
+            return;
+        }
+        state->last_played = timer_read();
+#endif
+
+        /* Events keep their recorded spacing, so tap and hold
+         * decisions come out the same as when they were recorded. */
+        state->time += delta;
+        record.event.time = state->time;
+        state->index      = next;
+
+        dynamic_macro_play_track(state, &record);
+
+        /* One event per call. Playing this event may start the other
+         * macro, which then takes over until it is done. */
+        process_record(&record);
+
+        if (state != &playback[playback_depth - 1] || state->index < state->length) {
+            return;
+        }
+    }
+
+    dynamic_macro_play_end();
 }
 
 /* Handle the key events related to the dynamic macros.
@@ -252,18 +503,20 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
-                    macro_id = 1;
-                    return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
-                    macro_id = 2;
+                    if (dynamic_macro_is_playing()) {
+                        /* Recording would overwrite the events being played. */
+                        dprintln("dynamic macro: ignoring record key during playback");
+                        return false;
+                    }
+                    macro_id = keycode == QK_DYNAMIC_MACRO_RECORD_START_1 ? 1 : 2;
+                    dynamic_macro_record_start(macro_id - 1);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(0);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(1);
                     return false;
             }
         }
@@ -289,14 +542,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_kb(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_record_key(macro_id - 1, record);
                 }
                 return true;
                 break;
@@ -35,6 +35,22 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* The buffer takes as much RAM as DYNAMIC_MACRO_SIZE unpacked key
+ * records would. Events are packed into 4 bytes in the common case,
+ * so it holds several times that many. May be overridden with a size
+ * in bytes.
+ */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE ((uint16_t)(DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t)))
+#endif
+
+/* The number of keys a macro being played may hold down at once. The
+ * keys it still holds are released when it ends.
+ */
+#ifndef DYNAMIC_MACRO_HELD_KEYS
+#    define DYNAMIC_MACRO_HELD_KEYS 8
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_record_start_kb(int8_t direction);
@@ -48,3 +64,5 @@ bool dynamic_macro_record_end_user(int8_t direction);
 bool dynamic_macro_valid_key_kb(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_valid_key_user(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_stop_recording(void);
+bool dynamic_macro_is_playing(void);
+void dynamic_macro_task(void);
@@ -31,6 +31,10 @@ static uint8_t chord[MAX_STROKE_SIZE] = {0};
 // At the end of this scenario given as an example, `chord` would have five bits set to 1 but
 // `n_pressed_keys` would be set to 2 because there are only two keys currently being pressed down.
 static int8_t n_pressed_keys = 0;
+#ifdef STENO_CHORD_TIMESTAMP
+// Event time of the first key press of the current chord.
+static uint16_t chord_time = 0;
+#endif
 
 #ifdef STENO_ENABLE_ALL
 static steno_mode_t mode;
@@ -50,9 +54,8 @@ static inline void steno_clear_chord(void) {
 void send_steno_chord_gemini(void) {
     // Set MSB to 1 to indicate the start of packet
     chord[0] |= 0x80;
-    for (uint8_t i = 0; i < GEMINI_STROKE_SIZE; ++i) {
-        virtser_send(chord[i]);
-    }
+    // The chord already has the layout of the packet, so it is sent as is.
+    virtser_send_buffer(chord, GEMINI_STROKE_SIZE);
 }
 #    else
 #        pragma message "VIRTSER_ENABLE = yes is required for Gemini PR to work properly out of the box!"
@@ -90,18 +93,21 @@ static const uint8_t boltmap[64] PROGMEM = {TXB_NUL, TXB_NUM, TXB_NUM, TXB_NUM,
 
 #    ifdef VIRTSER_ENABLE
 static void send_steno_chord_bolt(void) {
+    uint8_t packet[BOLT_STROKE_SIZE + 1];
+    uint8_t length = 0;
     for (uint8_t i = 0; i < BOLT_STROKE_SIZE; ++i) {
         // TX Bolt uses variable length packets where each byte corresponds to a bit array of certain keys.
         // If a user chorded the keys of the first group with keys of the last group, for example, there
         // would be bytes of 0x00 in `chord` for the middle groups which we mustn't send.
         if (chord[i]) {
-            virtser_send(chord[i]);
+            packet[length++] = chord[i];
         }
     }
     // Sending a null packet is not always necessary, but it is simpler and more reliable
     // to unconditionally send it every time instead of keeping track of more states and
     // creating more branches in the execution of the program.
-    virtser_send(0);
+    packet[length++] = 0;
+    virtser_send_buffer(packet, length);
 }
 #    else
 #        pragma message "VIRTSER_ENABLE = yes is required for TX Bolt to work properly out of the box!"
@@ -135,6 +141,12 @@ void steno_set_mode(steno_mode_t new_mode) {
 }
 #endif // STENO_ENABLE_ALL
 
+#ifdef STENO_CHORD_TIMESTAMP
+uint16_t steno_chord_time(void) {
+    return chord_time;
+}
+#endif // STENO_CHORD_TIMESTAMP
+
 /* override to intercept chords right before they get sent.
  * return zero to suppress normal sending behavior.
  */
@@ -188,6 +200,11 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
 #endif // STENO_COMBINEDMAP
         case STN__MIN ... STN__MAX:
             if (record->event.pressed) {
+#ifdef STENO_CHORD_TIMESTAMP
+                if (n_pressed_keys == 0) {
+                    chord_time = record->event.time;
+                }
+#endif // STENO_CHORD_TIMESTAMP
                 n_pressed_keys++;
                 switch (mode) {
 #ifdef STENO_ENABLE_BOLT
@@ -40,3 +40,6 @@ bool process_steno(uint16_t keycode, keyrecord_t *record);
 void steno_init(void);
 void steno_set_mode(steno_mode_t mode);
 #endif // STENO_ENABLE_ALL
+#ifdef STENO_CHORD_TIMESTAMP
+uint16_t steno_chord_time(void);
+#endif // STENO_CHORD_TIMESTAMP
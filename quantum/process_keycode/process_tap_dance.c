@@ -23,8 +23,48 @@
 #include "wait.h"
 #include "keymap_introspection.h"
 
-static uint16_t active_td;
-static uint16_t last_tap_time;
+typedef struct {
+    tap_dance_state_t state; // must be first, so that a state pointer leads back to its slot
+    uint8_t           index;
+    bool              in_use;
+} tap_dance_slot_t;
+
+static uint16_t         active_td;
+static uint16_t         last_tap_time;
+static tap_dance_slot_t tap_dance_slots[TAP_DANCE_MAX_SIMULTANEOUS];
+
+static tap_dance_slot_t *tap_dance_find_slot(uint8_t index) {
+    for (uint8_t i = 0; i < TAP_DANCE_MAX_SIMULTANEOUS; i++) {
+        if (tap_dance_slots[i].in_use && tap_dance_slots[i].index == index) {
+            return &tap_dance_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static tap_dance_slot_t *tap_dance_alloc_slot(uint8_t index) {
+    tap_dance_slot_t *slot = tap_dance_find_slot(index);
+    if (slot) {
+        return slot;
+    }
+
+    for (uint8_t i = 0; i < TAP_DANCE_MAX_SIMULTANEOUS; i++) {
+        if (!tap_dance_slots[i].in_use) {
+            tap_dance_slots[i] = (tap_dance_slot_t){.index = index, .in_use = true};
+            return &tap_dance_slots[i];
+        }
+    }
+    return NULL;
+}
+
+tap_dance_state_t *tap_dance_get_state(uint8_t tap_dance_idx) {
+    tap_dance_slot_t *slot = tap_dance_find_slot(tap_dance_idx);
+    return slot ? &slot->state : NULL;
+}
+
+uint8_t tap_dance_state_index(tap_dance_state_t *state) {
+    return ((tap_dance_slot_t *)state)->index;
+}
 
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data) {
     tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
@@ -86,58 +126,66 @@ static inline void _process_tap_dance_action_fn(tap_dance_state_t *state, void *
     }
 }
 
-static inline void process_tap_dance_action_on_each_tap(tap_dance_action_t *action) {
-    action->state.count++;
-    action->state.weak_mods = get_mods();
-    action->state.weak_mods |= get_weak_mods();
+static inline void process_tap_dance_action_on_each_tap(const tap_dance_action_t *action, tap_dance_state_t *state) {
+    state->count++;
+    state->weak_mods = get_mods();
+    state->weak_mods |= get_weak_mods();
 #ifndef NO_ACTION_ONESHOT
-    action->state.oneshot_mods = get_oneshot_mods();
+    state->oneshot_mods = get_oneshot_mods();
 #endif
-    _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_each_tap);
+    _process_tap_dance_action_fn(state, action->user_data, action->fn.on_each_tap);
 }
 
-static inline void process_tap_dance_action_on_each_release(tap_dance_action_t *action) {
-    _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_each_release);
+static inline void process_tap_dance_action_on_each_release(const tap_dance_action_t *action, tap_dance_state_t *state) {
+    _process_tap_dance_action_fn(state, action->user_data, action->fn.on_each_release);
 }
 
-static inline void process_tap_dance_action_on_reset(tap_dance_action_t *action) {
-    _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_reset);
-    del_weak_mods(action->state.weak_mods);
+static inline void process_tap_dance_action_on_reset(const tap_dance_action_t *action, tap_dance_state_t *state) {
+    _process_tap_dance_action_fn(state, action->user_data, action->fn.on_reset);
+    del_weak_mods(state->weak_mods);
 #ifndef NO_ACTION_ONESHOT
-    del_mods(action->state.oneshot_mods);
+    del_mods(state->oneshot_mods);
 #endif
     send_keyboard_report();
-    action->state = (const tap_dance_state_t){0};
+    // Hand the slot back to the pool
+    *(tap_dance_slot_t *)state = (const tap_dance_slot_t){0};
 }
 
-static inline void process_tap_dance_action_on_dance_finished(tap_dance_action_t *action) {
-    if (!action->state.finished) {
-        action->state.finished = true;
-        add_weak_mods(action->state.weak_mods);
+static inline void process_tap_dance_action_on_dance_finished(const tap_dance_action_t *action, tap_dance_state_t *state) {
+    if (!state->finished) {
+        state->finished = true;
+        add_weak_mods(state->weak_mods);
 #ifndef NO_ACTION_ONESHOT
-        add_mods(action->state.oneshot_mods);
+        add_mods(state->oneshot_mods);
 #endif
         send_keyboard_report();
-        _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_dance_finished);
+        _process_tap_dance_action_fn(state, action->user_data, action->fn.on_dance_finished);
     }
     active_td = 0;
-    if (!action->state.pressed) {
+    if (!state->pressed) {
         // There will not be a key release event, so reset now.
-        process_tap_dance_action_on_reset(action);
+        process_tap_dance_action_on_reset(action, state);
     }
 }
 
 bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record) {
-    tap_dance_action_t *action;
+    const tap_dance_action_t *action;
+    tap_dance_state_t        *state;
 
     if (!record->event.pressed) return false;
 
     if (!active_td || keycode == active_td) return false;
 
-    action                             = tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td));
-    action->state.interrupted          = true;
-    action->state.interrupting_keycode = keycode;
-    process_tap_dance_action_on_dance_finished(action);
+    action = tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td));
+    state  = tap_dance_get_state(QK_TAP_DANCE_GET_INDEX(active_td));
+    if (!state) {
+        active_td = 0;
+        return false;
+    }
+
+    state->interrupted          = true;
+    state->interrupting_keycode = keycode;
+    process_tap_dance_action_on_dance_finished(action, state);
 
     // Tap dance actions can leave some weak mods active (e.g., if the tap dance is mapped to a keycode with
     // modifiers), but these weak mods should not affect the keypress which interrupted the tap dance.
@@ -151,8 +199,9 @@ bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record) {
 }
 
 bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
-    int                 td_index;
-    tap_dance_action_t *action;
+    int                       td_index;
+    const tap_dance_action_t *action;
+    tap_dance_slot_t         *slot;
 
     switch (keycode) {
         case QK_TAP_DANCE ... QK_TAP_DANCE_MAX:
@@ -162,15 +211,28 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
             }
             action = tap_dance_get(td_index);
 
-            action->state.pressed = record->event.pressed;
             if (record->event.pressed) {
-                last_tap_time = timer_read();
-                process_tap_dance_action_on_each_tap(action);
-                active_td = action->state.finished ? 0 : keycode;
+                slot = tap_dance_alloc_slot(td_index);
+                if (!slot) {
+                    dprintf("Tap dance %d dropped, more than %d dances in progress\n", td_index, TAP_DANCE_MAX_SIMULTANEOUS);
+                    return false;
+                }
+
+                slot->state.pressed = true;
+                last_tap_time       = timer_read();
+                process_tap_dance_action_on_each_tap(action, &slot->state);
+                active_td = slot->state.finished ? 0 : keycode;
             } else {
-                process_tap_dance_action_on_each_release(action);
-                if (action->state.finished) {
-                    process_tap_dance_action_on_reset(action);
+                slot = tap_dance_find_slot(td_index);
+                if (!slot) {
+                    // Already reset, or dropped on press
+                    return false;
+                }
+
+                slot->state.pressed = false;
+                process_tap_dance_action_on_each_release(action, &slot->state);
+                if (slot->state.finished) {
+                    process_tap_dance_action_on_reset(action, &slot->state);
                     if (active_td == keycode) {
                         active_td = 0;
                     }
@@ -184,17 +246,22 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 }
 
 void tap_dance_task(void) {
-    tap_dance_action_t *action;
+    tap_dance_state_t *state;
 
     if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
 
-    action = tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td));
-    if (!action->state.interrupted) {
-        process_tap_dance_action_on_dance_finished(action);
+    state = tap_dance_get_state(QK_TAP_DANCE_GET_INDEX(active_td));
+    if (!state) {
+        active_td = 0;
+        return;
+    }
+
+    if (!state->interrupted) {
+        process_tap_dance_action_on_dance_finished(tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td)), state);
     }
 }
 
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
-    process_tap_dance_action_on_reset((tap_dance_action_t *)state);
+    process_tap_dance_action_on_reset(tap_dance_get(tap_dance_state_index(state)), state);
 }
@@ -21,6 +21,11 @@
 #include "action.h"
 #include "quantum_keycodes.h"
 
+// Number of tap dances that can be in progress or held down at the same time
+#ifndef TAP_DANCE_MAX_SIMULTANEOUS
+#    define TAP_DANCE_MAX_SIMULTANEOUS 4
+#endif
+
 typedef struct {
     uint16_t interrupting_keycode;
     uint8_t  count;
@@ -36,7 +41,6 @@ typedef struct {
 typedef void (*tap_dance_user_fn_t)(tap_dance_state_t *state, void *user_data);
 
 typedef struct tap_dance_action_t {
-    tap_dance_state_t state;
     struct {
         tap_dance_user_fn_t on_each_tap;
         tap_dance_user_fn_t on_dance_finished;
@@ -76,10 +80,20 @@ typedef struct {
     { .fn = {user_fn_on_each_tap, user_fn_on_dance_finished, user_fn_on_dance_reset, user_fn_on_each_release}, .user_data = NULL, }
 
 #define TD_INDEX(code) QK_TAP_DANCE_GET_INDEX(code)
-#define TAP_DANCE_KEYCODE(state) TD(((tap_dance_action_t *)state) - tap_dance_actions)
+#define TAP_DANCE_KEYCODE(state) TD(tap_dance_state_index(state))
 
 void reset_tap_dance(tap_dance_state_t *state);
 
+/**
+ * Get the state of a tap dance, or NULL if it is not currently being danced.
+ */
+tap_dance_state_t *tap_dance_get_state(uint8_t tap_dance_idx);
+
+/**
+ * Get the index of the tap dance that a state belongs to.
+ */
+uint8_t tap_dance_state_index(tap_dance_state_t *state);
+
 /* To be used internally */
 
 bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record);
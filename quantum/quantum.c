@@ -93,6 +93,10 @@
 #    include "process_oneshot.h"
 #endif
 
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -235,6 +239,10 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef I2C_QUEUE_ENABLE
+    // Nothing will run the queue after the reset, so send the final frame now
+    i2c_queue_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -338,6 +346,10 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
+    // Handlers that only act on their own keycode range are guarded by a
+    // range check, so that ordinary keys skip the call entirely. Handlers that
+    // observe every key (music mode, caps word, autocorrect, ...) are always
+    // called. Either way the order below is the processing order.
     if (!(
 #if defined(KEY_LOCK_ENABLE)
             // Must run first to be able to mask key_up events.
@@ -368,22 +380,22 @@ bool process_record_quantum(keyrecord_t *record) {
             process_secure(keycode, record) &&
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+            (!IS_QK_SEQUENCER(keycode) || process_sequencer(keycode, record)) &&
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+            (!IS_QK_MIDI(keycode) || process_midi(keycode, record)) &&
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+            (!IS_QK_AUDIO(keycode) || process_audio(keycode, record)) &&
 #endif
 #if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
+            (!IS_QK_LIGHTING(keycode) || process_backlight(keycode, record)) &&
 #endif
 #if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
+            (!IS_QK_LIGHTING(keycode) || process_led_matrix(keycode, record)) &&
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+            (!IS_QK_STENO(keycode) || process_steno(keycode, record)) &&
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
             process_music(keycode, record) &&
@@ -413,7 +425,7 @@ bool process_record_quantum(keyrecord_t *record) {
             process_space_cadet(keycode, record) &&
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+            (!IS_QK_MAGIC(keycode) || process_magic(keycode, record)) &&
 #endif
 #ifdef GRAVE_ESC_ENABLE
             process_grave_esc(keycode, record) &&
@@ -422,13 +434,13 @@ bool process_record_quantum(keyrecord_t *record) {
             process_underglow(keycode, record) &&
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-            process_rgb_matrix(keycode, record) &&
+            (!IS_QK_LIGHTING(keycode) || process_rgb_matrix(keycode, record)) &&
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+            (!IS_QK_JOYSTICK(keycode) || process_joystick(keycode, record)) &&
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+            (!IS_QK_PROGRAMMABLE_BUTTON(keycode) || process_programmable_button(keycode, record)) &&
 #endif
 #ifdef AUTOCORRECT_ENABLE
             process_autocorrect(keycode, record) &&
@@ -443,7 +455,7 @@ bool process_record_quantum(keyrecord_t *record) {
             process_layer_lock(keycode, record) &&
 #endif
 #ifdef CONNECTION_ENABLE
-            process_connection(keycode, record) &&
+            (!IS_QK_CONNECTION(keycode) || process_connection(keycode, record)) &&
 #endif
 #ifndef NO_ACTION_ONESHOT
             process_oneshot(keycode, record) &&
@@ -533,6 +545,11 @@ void suspend_power_down_quantum(void) {
     pointing_device_task();
 #    endif
 #endif
+#ifdef I2C_QUEUE_ENABLE
+    // The main loop does not run while suspended, so the queue has to be
+    // drained here for the LEDs to actually turn off
+    i2c_queue_flush();
+#endif
 }
 
 __attribute__((weak)) void suspend_wakeup_init_quantum(void) {
@@ -0,0 +1,79 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "timer.h"
+
+/**
+ * \file
+ *
+ * \brief Adaptive slice sizing and frame statistics, used by both LED Matrix and RGB Matrix.
+ *
+ * Both lighting systems render a frame over several task runs, a slice of LEDs at a time. With a render budget
+ * configured, each render pass is timed and folded into a moving average, and the slice size is adapted between
+ * frames so that a pass takes about as long as the budget. The size only changes between frames, so every slice
+ * of a frame still covers a contiguous, non-overlapping LED range.
+ *
+ * Only these helpers are common to the two systems. Each keeps its own task state machine, effect dispatch, hit
+ * buffers and flushing, and calls the helpers from it.
+ */
+
+typedef struct {
+    uint8_t  process_limit; // only changed between frames
+    uint16_t slice_time;    // moving average of a render pass, in 1/256 ms
+    uint16_t render_time;
+    uint16_t render_load;
+    uint16_t frame_count;
+    uint16_t frame_rate;
+    uint32_t stats_timer;
+} render_budget_t;
+
+#define RENDER_BUDGET_INIT(limit) {.process_limit = (limit)}
+
+/**
+ * \brief Roll the per-second frame rate and render load statistics over.
+ */
+static inline void render_budget_stats(render_budget_t *budget) {
+    if (timer_elapsed32(budget->stats_timer) >= 1000) {
+        budget->frame_rate  = budget->frame_count;
+        budget->render_load = budget->render_time;
+        budget->frame_count = 0;
+        budget->render_time = 0;
+        budget->stats_timer = timer_read32();
+    }
+}
+
+/**
+ * \brief Record the time taken by a render pass.
+ *
+ * A pass shorter than a millisecond reads as 0 or 1 depending on whether it straddles a tick, so the average
+ * still converges on its real cost.
+ */
+static inline void render_budget_account(render_budget_t *budget, uint32_t elapsed) {
+    if (elapsed > UINT8_MAX) elapsed = UINT8_MAX;
+    budget->render_time += elapsed;
+    budget->slice_time = budget->slice_time - (budget->slice_time >> 3) + (elapsed << 5);
+}
+
+/**
+ * \brief Resize the slice for the next frame.
+ *
+ * The slice is shrunk when the average pass is over `budget_ms`, and grown when it is under half of it.
+ */
+static inline void render_budget_adapt(render_budget_t *budget, uint8_t budget_ms, uint8_t led_count) {
+    if (budget->slice_time > ((uint16_t)budget_ms << 8)) {
+        if (budget->process_limit > 1) budget->process_limit -= (budget->process_limit + 3) / 4;
+    } else if (budget->slice_time < ((uint16_t)budget_ms << 7)) {
+        uint16_t limit        = budget->process_limit + budget->process_limit / 4 + 1;
+        budget->process_limit = limit < led_count ? limit : led_count;
+    }
+}
+
+/**
+ * \brief Record that a frame has been flushed to the LEDs.
+ */
+static inline void render_budget_frame(render_budget_t *budget) {
+    budget->frame_count++;
+}
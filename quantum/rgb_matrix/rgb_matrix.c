@@ -22,6 +22,7 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "render_budget.h"
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -79,6 +80,22 @@ static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
 
+#ifdef RGB_MATRIX_OVERLAY_ENABLE
+// sparse overlay layer, blended into the effect as it renders
+static rgb_overlay_t rgb_overlays[RGB_MATRIX_OVERLAY_COUNT] = {[0 ... RGB_MATRIX_OVERLAY_COUNT - 1] = {.led = UINT8_MAX}};
+static uint8_t       rgb_overlay_slot[RGB_MATRIX_LED_COUNT] = {[0 ... RGB_MATRIX_LED_COUNT - 1] = UINT8_MAX}; // index into rgb_overlays, or UINT8_MAX
+static uint8_t       rgb_overlay_count;
+static bool          rgb_overlay_compositing;
+#endif
+
+#ifdef RGB_MATRIX_RENDER_BUDGET
+// adaptive render slicing
+static render_budget_t rgb_render_budget = RENDER_BUDGET_INIT(RGB_MATRIX_LED_PROCESS_LIMIT);
+#    define RGB_MATRIX_SLICE_SIZE rgb_render_budget.process_limit
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#    define RGB_MATRIX_SLICE_SIZE RGB_MATRIX_LED_PROCESS_LIMIT
+#endif
+
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -158,7 +175,64 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
     return index;
 }
 
+#ifdef RGB_MATRIX_OVERLAY_ENABLE
+static uint8_t rgb_overlay_blend(uint8_t base, uint8_t over, uint8_t alpha, uint8_t mode) {
+    switch (mode) {
+        case RGB_MATRIX_BLEND_ADD:
+            return qadd8(base, scale8(over, alpha));
+        case RGB_MATRIX_BLEND_MAX: {
+            uint8_t scaled = scale8(over, alpha);
+            return scaled > base ? scaled : base;
+        }
+        default:
+            return blend8(base, over, alpha);
+    }
+}
+
+bool rgb_matrix_overlay_set(uint8_t index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha, rgb_matrix_blend_t mode) {
+    if (index >= RGB_MATRIX_LED_COUNT) return false;
+
+    uint8_t slot = rgb_overlay_slot[index];
+    if (slot == UINT8_MAX) {
+        if (rgb_overlay_count >= RGB_MATRIX_OVERLAY_COUNT) return false;
+        for (slot = 0; rgb_overlays[slot].led != UINT8_MAX; slot++) {
+        }
+        rgb_overlays[slot].led  = index;
+        rgb_overlay_slot[index] = slot;
+        rgb_overlay_count++;
+    }
+
+    rgb_overlays[slot].alpha = alpha;
+    rgb_overlays[slot].mode  = mode;
+    rgb_overlays[slot].color = (rgb_t){.r = red, .g = green, .b = blue};
+    return true;
+}
+
+void rgb_matrix_overlay_clear(uint8_t index) {
+    if (index >= RGB_MATRIX_LED_COUNT || rgb_overlay_slot[index] == UINT8_MAX) return;
+
+    rgb_overlays[rgb_overlay_slot[index]].led = UINT8_MAX;
+    rgb_overlay_slot[index]                   = UINT8_MAX;
+    rgb_overlay_count--;
+}
+
+void rgb_matrix_overlay_clear_all(void) {
+    memset(rgb_overlays, UINT8_MAX, sizeof(rgb_overlays));
+    memset(rgb_overlay_slot, UINT8_MAX, sizeof(rgb_overlay_slot));
+    rgb_overlay_count = 0;
+}
+#endif
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_OVERLAY_ENABLE
+    // only LEDs with an overlay pay for blending, and the result still reaches the driver in one write
+    if (rgb_overlay_compositing && index >= 0 && index < RGB_MATRIX_LED_COUNT && rgb_overlay_slot[index] != UINT8_MAX) {
+        rgb_overlay_t *overlay = &rgb_overlays[rgb_overlay_slot[index]];
+        red                    = rgb_overlay_blend(red, overlay->color.r, overlay->alpha, overlay->mode);
+        green                  = rgb_overlay_blend(green, overlay->color.g, overlay->alpha, overlay->mode);
+        blue                   = rgb_overlay_blend(blue, overlay->color.b, overlay->alpha, overlay->mode);
+    }
+#endif
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
 }
 
@@ -167,16 +241,66 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
+#    ifdef RGB_MATRIX_OVERLAY_ENABLE
+    if (rgb_overlay_compositing && rgb_overlay_count) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+            rgb_matrix_set_color(i, red, green, blue);
+        return;
+    }
+#    endif
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
 
-void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
-#ifndef RGB_MATRIX_SPLIT
-    if (!is_keyboard_master()) return;
-#endif
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_matrix_add_hit(uint8_t led, uint16_t tick) {
+    uint8_t index                = last_hit_buffer.count;
+    last_hit_buffer.x[index]     = g_led_config.point[led].x;
+    last_hit_buffer.y[index]     = g_led_config.point[led].y;
+    last_hit_buffer.index[index] = led;
+    last_hit_buffer.tick[index]  = tick;
+    last_hit_buffer.count++;
+#    ifdef RGB_MATRIX_KEYREACTIVE_DISTANCE_CACHE
+    // Distances only change when a hit is added, so reactive effects
+    // don't have to recompute them on every frame
+    for (uint8_t j = 0; j < RGB_MATRIX_LED_COUNT; j++) {
+        int16_t dx                     = g_led_config.point[j].x - last_hit_buffer.x[index];
+        int16_t dy                     = g_led_config.point[j].y - last_hit_buffer.y[index];
+        last_hit_buffer.dist[index][j] = sqrt16(dx * dx + dy * dy);
+    }
+#    endif
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+void rgb_matrix_get_hits(rgb_matrix_hits_t *hits) {
+    memset(hits, 0, sizeof(rgb_matrix_hits_t));
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    // tick grows by exactly as much as rgb_timer_buffer does, so the
+    // difference stays the same from frame to frame until the hits change.
+    // Saturated hits no longer affect any effect and would break that, so
+    // they are left out.
+    for (uint8_t i = 0; i < last_hit_buffer.count; i++) {
+        if (last_hit_buffer.tick[i] == UINT16_MAX) continue;
+        hits->index[hits->count] = last_hit_buffer.index[i];
+        hits->time[hits->count]  = (uint16_t)rgb_timer_buffer - last_hit_buffer.tick[i];
+        hits->count++;
+    }
+#    endif
+}
+
+void rgb_matrix_set_hits(const rgb_matrix_hits_t *hits) {
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    last_hit_buffer.count = 0;
+    for (uint8_t i = 0; i < hits->count && i < LED_HITS_TO_REMEMBER; i++) {
+        rgb_matrix_add_hit(hits->index[i], (uint16_t)rgb_timer_buffer - hits->time[i]);
+    }
+#    endif
+}
+#endif // RGB_MATRIX_SPLIT_LOCKSTEP
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_matrix_record_hit(uint8_t row, uint8_t col, bool pressed) {
     uint8_t led[LED_HITS_TO_REMEMBER];
     uint8_t led_count = 0;
 
@@ -194,16 +318,30 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
         memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
         memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
+#    ifdef RGB_MATRIX_KEYREACTIVE_DISTANCE_CACHE
+        memmove(&last_hit_buffer.dist[0], &last_hit_buffer.dist[led_count], (LED_HITS_TO_REMEMBER - led_count) * RGB_MATRIX_LED_COUNT);
+#    endif
         last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
     }
 
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        rgb_matrix_add_hit(led[i], 0);
+    }
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
+#ifndef RGB_MATRIX_SPLIT
+    if (!is_keyboard_master()) return;
+#endif
+
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    // the slave takes its hits from the master instead, see rgb_matrix_set_hits()
+    if (is_keyboard_master())
+#    endif
+    {
+        rgb_matrix_record_hit(row, col, pressed);
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -283,12 +421,31 @@ static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
 
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    // resize the slices between frames, so that every slice of a frame has the same size
+    render_budget_adapt(&rgb_render_budget, RGB_MATRIX_RENDER_BUDGET, RGB_MATRIX_LED_COUNT);
+#endif
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker = last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#if defined(RGB_MATRIX_SPLIT_LOCKSTEP) && RGB_MATRIX_LED_FLUSH_LIMIT > 0
+    // snap the frame time to the frame grid, so that both halves render
+    // exactly the same frame regardless of when their task runs. Without a
+    // flush limit there is no grid to snap to.
+    uint16_t frame_offset = g_rgb_timer % RGB_MATRIX_LED_FLUSH_LIMIT;
+    g_rgb_timer -= frame_offset;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    for (uint8_t i = 0; i < g_last_hit_tracker.count; i++) {
+        if (g_last_hit_tracker.tick[i] == UINT16_MAX) continue;
+        g_last_hit_tracker.tick[i] = g_last_hit_tracker.tick[i] > frame_offset ? g_last_hit_tracker.tick[i] - frame_offset : 0;
+    }
+#    endif
+#endif // defined(RGB_MATRIX_SPLIT_LOCKSTEP) && RGB_MATRIX_LED_FLUSH_LIMIT > 0
+
     // next task
     rgb_task_state = RENDERING;
 }
@@ -301,6 +458,11 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#ifdef RGB_MATRIX_OVERLAY_ENABLE
+    // overlays only apply to what the effect draws, indicators still draw over the top
+    rgb_overlay_compositing = effect != RGB_MATRIX_NONE && effect != UINT8_MAX;
+#endif
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -350,6 +512,10 @@ static void rgb_task_render(uint8_t effect) {
             return;
     }
 
+#ifdef RGB_MATRIX_OVERLAY_ENABLE
+    rgb_overlay_compositing = false;
+#endif
+
     rgb_effect_params.iter++;
 
     // next task
@@ -370,12 +536,19 @@ static void rgb_task_flush(uint8_t effect) {
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
 
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    render_budget_frame(&rgb_render_budget);
+#endif
+
     // next task
     rgb_task_state = SYNCING;
 }
 
 void rgb_matrix_task(void) {
     rgb_task_timers();
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    render_budget_stats(&rgb_render_budget);
+#endif
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
@@ -391,7 +564,12 @@ void rgb_matrix_task(void) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_RENDER_BUDGET
+            // yield to the matrix scan for the rest of the millisecond in which a key changed
+            if (last_matrix_activity_elapsed() == 0) break;
+            uint32_t render_start = timer_read32();
+#endif
             rgb_task_render(effect);
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
@@ -399,7 +577,10 @@ void rgb_matrix_task(void) {
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
-            break;
+#ifdef RGB_MATRIX_RENDER_BUDGET
+            render_budget_account(&rgb_render_budget, timer_elapsed32(render_start));
+#endif
+        } break;
         case FLUSHING:
             rgb_task_flush(effect);
             break;
@@ -428,16 +609,16 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_SLICE_SIZE)
 #    if defined(RGB_MATRIX_SPLIT)
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_SLICE_SIZE * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_SLICE_SIZE;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
     if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
 #    else
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_SLICE_SIZE * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_SLICE_SIZE;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
 #    endif
 #else
@@ -514,6 +695,20 @@ bool rgb_matrix_get_suspend_state(void) {
     return suspend_state;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET
+uint16_t rgb_matrix_get_frame_rate(void) {
+    return rgb_render_budget.frame_rate;
+}
+
+uint16_t rgb_matrix_get_render_load(void) {
+    return rgb_render_budget.render_load;
+}
+
+uint8_t rgb_matrix_get_process_limit(void) {
+    return rgb_render_budget.process_limit;
+}
+#endif
+
 void rgb_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     rgb_matrix_config.enable ^= 1;
     rgb_task_state = STARTING;
@@ -90,6 +90,10 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#if defined(RGB_MATRIX_OVERLAY_ENABLE) && !defined(RGB_MATRIX_OVERLAY_COUNT)
+#    define RGB_MATRIX_OVERLAY_COUNT 16
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -220,6 +224,23 @@ void        rgb_matrix_set_flags(led_flags_t flags);
 void        rgb_matrix_set_flags_noeeprom(led_flags_t flags);
 void        rgb_matrix_update_pwm_buffers(void);
 
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+void rgb_matrix_get_hits(rgb_matrix_hits_t *hits);
+void rgb_matrix_set_hits(const rgb_matrix_hits_t *hits);
+#endif
+
+#ifdef RGB_MATRIX_OVERLAY_ENABLE
+bool rgb_matrix_overlay_set(uint8_t index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha, rgb_matrix_blend_t mode);
+void rgb_matrix_overlay_clear(uint8_t index);
+void rgb_matrix_overlay_clear_all(void);
+#endif
+
+#ifdef RGB_MATRIX_RENDER_BUDGET
+uint16_t rgb_matrix_get_frame_rate(void);
+uint16_t rgb_matrix_get_render_load(void);
+uint8_t  rgb_matrix_get_process_limit(void);
+#endif
+
 #ifdef RGB_MATRIX_MODE_NAME_ENABLE
 const char *rgb_matrix_get_mode_name(uint8_t mode);
 #endif // RGB_MATRIX_MODE_NAME_ENABLE
@@ -39,11 +39,37 @@ typedef struct PACKED {
     uint8_t  y[LED_HITS_TO_REMEMBER];
     uint8_t  index[LED_HITS_TO_REMEMBER];
     uint16_t tick[LED_HITS_TO_REMEMBER];
+#    ifdef RGB_MATRIX_KEYREACTIVE_DISTANCE_CACHE
+    uint8_t dist[LED_HITS_TO_REMEMBER][RGB_MATRIX_LED_COUNT]; // distance from each hit to every LED
+#    endif
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+typedef struct PACKED {
+    uint8_t  count;
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint16_t time[LED_HITS_TO_REMEMBER]; // lower 16 bits of the sync timer when the hit happened
+} rgb_matrix_hits_t;
+#endif // RGB_MATRIX_SPLIT_LOCKSTEP
+
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
+#ifdef RGB_MATRIX_OVERLAY_ENABLE
+typedef enum rgb_matrix_blend_t {
+    RGB_MATRIX_BLEND_ALPHA, // mix the overlay color over the effect by alpha
+    RGB_MATRIX_BLEND_ADD,   // add the overlay color, scaled by alpha, to the effect
+    RGB_MATRIX_BLEND_MAX,   // take the brighter of each channel, the overlay scaled by alpha
+} rgb_matrix_blend_t;
+
+typedef struct PACKED {
+    uint8_t led; // UINT8_MAX when unused
+    uint8_t alpha;
+    uint8_t mode;
+    rgb_t   color;
+} rgb_overlay_t;
+#endif // RGB_MATRIX_OVERLAY_ENABLE
+
 typedef uint8_t led_flags_t;
 
 typedef struct PACKED {
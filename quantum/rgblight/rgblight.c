@@ -132,6 +132,9 @@ void rgblight_set_effect_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.effect_start_pos = start_pos;
     rgblight_ranges.effect_end_pos   = start_pos + num_leds;
     rgblight_ranges.effect_num_leds  = num_leds;
+#ifdef RGBLIGHT_USE_TIMER
+    animation_status.redraw = true;
+#endif
 }
 
 __attribute__((weak)) rgb_t rgblight_hsv_to_rgb(hsv_t hsv) {
@@ -503,11 +506,14 @@ void rgblight_sethsv_noeeprom_old(uint8_t hue, uint8_t sat, uint8_t val) {
 
 void rgblight_sethsv_eeprom_helper(uint8_t hue, uint8_t sat, uint8_t val, bool write_to_eeprom) {
     if (rgblight_config.enable) {
-#ifdef RGBLIGHT_SPLIT
         if (rgblight_config.hue != hue || rgblight_config.sat != sat || rgblight_config.val != val) {
+#ifdef RGBLIGHT_SPLIT
             RGBLIGHT_SPLIT_SET_CHANGE_HSVS;
-        }
 #endif
+#ifdef RGBLIGHT_USE_TIMER
+            animation_status.redraw = true;
+#endif
+        }
         rgblight_status.base_mode = mode_base_table[rgblight_config.mode];
         if (rgblight_config.mode == RGBLIGHT_MODE_STATIC_LIGHT) {
             // same static color
@@ -984,6 +990,7 @@ void rgblight_timer_task(void) {
     if (rgblight_status.timer_enabled) {
         effect_func_t effect_func   = rgblight_effect_dummy;
         uint16_t      interval_time = 2000; // dummy interval
+        bool          multistep     = false;
         uint8_t       delta         = rgblight_config.mode - rgblight_status.base_mode;
         animation_status.delta      = delta;
 
@@ -995,6 +1002,7 @@ void rgblight_timer_task(void) {
             // breathing mode
             interval_time = get_interval_time(&RGBLED_BREATHING_INTERVALS[delta], 1, 100);
             effect_func   = rgblight_effect_breathing;
+            multistep     = true;
         }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RAINBOW_MOOD
@@ -1002,6 +1010,7 @@ void rgblight_timer_task(void) {
             // rainbow mood mode
             interval_time = get_interval_time(&RGBLED_RAINBOW_MOOD_INTERVALS[delta], 5, 100);
             effect_func   = rgblight_effect_rainbow_mood;
+            multistep     = true;
         }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RAINBOW_SWIRL
@@ -1009,6 +1018,7 @@ void rgblight_timer_task(void) {
             // rainbow swirl mode
             interval_time = get_interval_time(&RGBLED_RAINBOW_SWIRL_INTERVALS[delta / 2], 1, 100);
             effect_func   = rgblight_effect_rainbow_swirl;
+            multistep     = true;
         }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_SNAKE
@@ -1053,6 +1063,7 @@ void rgblight_timer_task(void) {
 #    endif
         if (animation_status.restart) {
             animation_status.restart    = false;
+            animation_status.redraw     = true;
             animation_status.last_timer = sync_timer_read();
             animation_status.pos16      = 0; // restart signal to local each effect
         }
@@ -1072,8 +1083,17 @@ void rgblight_timer_task(void) {
             }
             oldpos16 = animation_status.pos16;
 #    endif
-            animation_status.last_timer += interval_time;
+            // Effects with a phase accumulator catch up on every interval
+            // that has passed, the others take one step per task run.
+            uint8_t steps = 1;
+            if (multistep) {
+                uint16_t behind = TIMER_DIFF_16(now, animation_status.last_timer) / interval_time;
+                steps += behind < UINT8_MAX - 1 ? behind : UINT8_MAX - 1;
+            }
+            animation_status.steps = steps;
+            animation_status.last_timer += steps * interval_time;
             effect_func(&animation_status);
+            animation_status.redraw = false;
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
             if (animation_status.pos16 == 0 && oldpos16 != 0) {
                 tick_flag = true;
@@ -1089,6 +1109,8 @@ void rgblight_timer_task(void) {
 
     if (deferred_set_layer_state) {
         deferred_set_layer_state = false;
+        // LEDs uncovered by a layer have to be repainted by the effect
+        animation_status.redraw = true;
 
         // Static modes don't have a ticker running to update the LEDs
         if (rgblight_status.timer_enabled == false) {
@@ -1127,15 +1149,35 @@ static uint8_t breathe_calc(uint8_t pos) {
 
 #endif
 
+#if defined(RGBLIGHT_EFFECT_BREATHING) || defined(RGBLIGHT_EFFECT_RAINBOW_MOOD) || defined(RGBLIGHT_EFFECT_RAINBOW_SWIRL)
+/*
+ * Advance an 8-bit phase by every interval that has passed. The phase stops
+ * at 0 when it wraps, so that the split animation sync still sees the start
+ * of each cycle.
+ */
+static uint8_t rgblight_advance_phase(animation_status_t *anim, uint8_t phase, bool reverse) {
+    uint8_t steps = anim->steps ? anim->steps : 1;
+    if (reverse) {
+        return (phase != 0 && steps > phase) ? 0 : phase - steps;
+    }
+    return (phase != 0 && phase + steps > UINT8_MAX) ? 0 : phase + steps;
+}
+#endif
+
 // Effects
 #ifdef RGBLIGHT_EFFECT_BREATHING
 
 __attribute__((weak)) const uint8_t RGBLED_BREATHING_INTERVALS[] PROGMEM = {30, 20, 10, 5};
 
 void rgblight_effect_breathing(animation_status_t *anim) {
-    uint8_t val = breathe_calc(anim->pos);
-    rgblight_sethsv_noeeprom_old(rgblight_config.hue, rgblight_config.sat, val);
-    anim->pos = (anim->pos + 1);
+    static uint8_t last_val = 0;
+    uint8_t        val      = breathe_calc(anim->pos);
+    // neighbouring phases often share a table entry, so only write the LEDs when the level changes
+    if (val != last_val || anim->redraw) {
+        rgblight_sethsv_noeeprom_old(rgblight_config.hue, rgblight_config.sat, val);
+        last_val = val;
+    }
+    anim->pos = rgblight_advance_phase(anim, anim->pos, false);
 }
 #endif
 
@@ -1144,7 +1186,7 @@ __attribute__((weak)) const uint8_t RGBLED_RAINBOW_MOOD_INTERVALS[] PROGMEM = {1
 
 void rgblight_effect_rainbow_mood(animation_status_t *anim) {
     rgblight_sethsv_noeeprom_old(anim->current_hue, rgblight_config.sat, rgblight_config.val);
-    anim->current_hue++;
+    anim->current_hue = rgblight_advance_phase(anim, anim->current_hue, false);
 }
 #endif
 
@@ -1165,19 +1207,27 @@ void rgblight_effect_rainbow_swirl(animation_status_t *anim) {
     }
     rgblight_set();
 
-    if (anim->delta % 2) {
-        anim->current_hue++;
-    } else {
-        anim->current_hue--;
-    }
+    anim->current_hue = rgblight_advance_phase(anim, anim->current_hue, !(anim->delta % 2));
 }
 #endif
 
 #ifdef RGBLIGHT_EFFECT_SNAKE
 __attribute__((weak)) const uint8_t RGBLED_SNAKE_INTERVALS[] PROGMEM = {100, 50, 20};
 
+static int8_t rgblight_snake_led(uint8_t pos, uint8_t j, int8_t increment) {
+    int8_t k = pos + j * increment;
+    if (k > RGBLIGHT_LED_COUNT) {
+        k = k % (RGBLIGHT_LED_COUNT);
+    }
+    if (k < 0) {
+        k = k + rgblight_ranges.effect_num_leds;
+    }
+    return k < rgblight_ranges.effect_num_leds ? k : -1;
+}
+
 void rgblight_effect_snake(animation_status_t *anim) {
-    static uint8_t pos = 0;
+    static uint8_t pos      = 0;
+    static uint8_t last_pos = 0;
     uint8_t        i, j;
     int8_t         k;
     int8_t         increment = 1;
@@ -1197,23 +1247,28 @@ void rgblight_effect_snake(animation_status_t *anim) {
     }
 #    endif
 
-    for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i + rgblight_ranges.effect_start_pos), 0, 0, 0);
-
+    // Only the LEDs under the snake change from step to step, so turn off
+    // where it was and draw where it is rather than repainting the range.
+    if (anim->redraw) {
+        for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
+            rgblight_driver.set_color(rgblight_led_index(i + rgblight_ranges.effect_start_pos), 0, 0, 0);
+        }
+    } else {
         for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
-            k = pos + j * increment;
-            if (k > RGBLIGHT_LED_COUNT) {
-                k = k % (RGBLIGHT_LED_COUNT);
-            }
-            if (k < 0) {
-                k = k + rgblight_ranges.effect_num_leds;
-            }
-            if (i == k) {
-                sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val * (RGBLIGHT_EFFECT_SNAKE_LENGTH - j) / RGBLIGHT_EFFECT_SNAKE_LENGTH), i + rgblight_ranges.effect_start_pos);
+            k = rgblight_snake_led(last_pos, j, increment);
+            if (k >= 0) {
+                rgblight_driver.set_color(rgblight_led_index(k + rgblight_ranges.effect_start_pos), 0, 0, 0);
             }
         }
     }
+    for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
+        k = rgblight_snake_led(pos, j, increment);
+        if (k >= 0) {
+            sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val * (RGBLIGHT_EFFECT_SNAKE_LENGTH - j) / RGBLIGHT_EFFECT_SNAKE_LENGTH), k + rgblight_ranges.effect_start_pos);
+        }
+    }
     rgblight_set();
+    last_pos = pos;
     if (increment == 1) {
         if (pos - RGBLIGHT_EFFECT_SNAKE_INCREMENT < 0) {
             pos = rgblight_ranges.effect_num_leds - 1;
@@ -1242,6 +1297,8 @@ void rgblight_effect_knight(animation_status_t *anim) {
     static int8_t low_bound  = 0;
     static int8_t high_bound = RGBLIGHT_EFFECT_KNIGHT_LENGTH - 1;
     static int8_t increment  = RGBLIGHT_EFFECT_KNIGHT_INCREMENT;
+    static int8_t last_low   = 0;
+    static int8_t last_high  = -1;
     uint8_t       i, cur;
 
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
@@ -1252,21 +1309,34 @@ void rgblight_effect_knight(animation_status_t *anim) {
         increment  = 1;
     }
 #    endif
-    // Set all the LEDs to 0
-    for (i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i), 0, 0, 0);
+    // the bar wraps onto itself when it is longer than the range, so only
+    // a full repaint gives the right result then
+    bool redraw = anim->redraw || RGBLIGHT_EFFECT_KNIGHT_LED_NUM > rgblight_ranges.effect_num_leds;
+    if (redraw) {
+        // Set all the LEDs to 0
+        for (i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
+            rgblight_driver.set_color(rgblight_led_index(i), 0, 0, 0);
+        }
     }
-    // Determine which LEDs should be lit up
+    // Determine which LEDs should be lit up, only touching the ones that
+    // entered or left the bar since the last step
     for (i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++) {
+        bool lit     = i >= low_bound && i <= high_bound;
+        bool was_lit = i >= last_low && i <= last_high;
+        if (!redraw && lit == was_lit) {
+            continue;
+        }
         cur = (i + RGBLIGHT_EFFECT_KNIGHT_OFFSET) % rgblight_ranges.effect_num_leds + rgblight_ranges.effect_start_pos;
 
-        if (i >= low_bound && i <= high_bound) {
+        if (lit) {
             sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, cur);
         } else {
             rgblight_driver.set_color(rgblight_led_index(cur), 0, 0, 0);
         }
     }
     rgblight_set();
+    last_low  = low_bound;
+    last_high = high_bound;
 
     // Move from low_bound to high_bound changing the direction we increment each
     // time a boundary is hit.
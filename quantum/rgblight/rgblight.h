@@ -425,6 +425,8 @@ typedef struct _animation_status_t {
     uint16_t last_timer;
     uint8_t  delta; /* mode - base_mode */
     bool     restart;
+    bool     redraw; /* every LED in the effect range has to be written on this step */
+    uint8_t  steps;  /* intervals that have passed since the last step */
     union {
         uint16_t pos16;
         uint8_t  pos;
@@ -69,6 +69,10 @@ enum serial_transaction_id {
     PUT_RGB_MATRIX,
 #endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_LOCKSTEP)
+    PUT_RGB_MATRIX_HITS,
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_LOCKSTEP)
+
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
     PUT_WPM,
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -603,6 +603,44 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+////////////////////////////////////////////////////
+// RGB Matrix hits
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_LOCKSTEP)
+
+static bool rgb_matrix_hits_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t   last_update = 0;
+    rgb_matrix_hits_t rgb_matrix_hits;
+    rgb_matrix_get_hits(&rgb_matrix_hits);
+    return send_if_data_mismatch(PUT_RGB_MATRIX_HITS, &last_update, &rgb_matrix_hits, &split_shmem->rgb_matrix_hits, sizeof(rgb_matrix_hits));
+}
+
+static void rgb_matrix_hits_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static rgb_matrix_hits_t last_hits = {0};
+    rgb_matrix_hits_t        rgb_matrix_hits;
+    split_shared_memory_lock();
+    memcpy(&rgb_matrix_hits, &split_shmem->rgb_matrix_hits, sizeof(rgb_matrix_hits_t));
+    split_shared_memory_unlock();
+
+    // Only rebuild the hit buffer when the master actually sent new hits
+    if (memcmp(&last_hits, &rgb_matrix_hits, sizeof(rgb_matrix_hits_t)) != 0) {
+        memcpy(&last_hits, &rgb_matrix_hits, sizeof(rgb_matrix_hits_t));
+        rgb_matrix_set_hits(&rgb_matrix_hits);
+    }
+}
+
+#    define TRANSACTIONS_RGB_MATRIX_HITS_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix_hits)
+#    define TRANSACTIONS_RGB_MATRIX_HITS_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix_hits)
+#    define TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS [PUT_RGB_MATRIX_HITS] = trans_initiator2target_initializer(rgb_matrix_hits),
+
+#else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_LOCKSTEP)
+
+#    define TRANSACTIONS_RGB_MATRIX_HITS_MASTER()
+#    define TRANSACTIONS_RGB_MATRIX_HITS_SLAVE()
+#    define TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS
+
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(RGB_MATRIX_SPLIT_LOCKSTEP)
+
 ////////////////////////////////////////////////////
 // WPM
 
@@ -936,6 +974,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_RGBLIGHT_REGISTRATIONS
     TRANSACTIONS_LED_MATRIX_REGISTRATIONS
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
+    TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
@@ -966,6 +1005,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_RGBLIGHT_MASTER();
     TRANSACTIONS_LED_MATRIX_MASTER();
     TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_HITS_MASTER();
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
@@ -989,6 +1029,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_RGBLIGHT_SLAVE();
     TRANSACTIONS_LED_MATRIX_SLAVE();
     TRANSACTIONS_RGB_MATRIX_SLAVE();
+    TRANSACTIONS_RGB_MATRIX_HITS_SLAVE();
     TRANSACTIONS_WPM_SLAVE();
     TRANSACTIONS_OLED_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
@@ -89,8 +89,10 @@ void ucis_cancel(void) {
 
 void register_ucis(uint8_t index) {
     const uint32_t *code_points = ucis_symbol_table[index].code_points;
+    uint8_t         length      = 0;
 
-    for (int i = 0; i < UCIS_MAX_CODE_POINTS && code_points[i]; i++) {
-        register_unicode(code_points[i]);
+    while (length < UCIS_MAX_CODE_POINTS && code_points[length]) {
+        length++;
     }
+    register_unicode_sequence(code_points, length);
 }
@@ -207,7 +207,16 @@ void unicode_input_mode_step_reverse(void) {
     cycle_unicode_input_mode(-1);
 }
 
-__attribute__((weak)) void unicode_input_start(void) {
+// Set while a string or sequence is being sent, so the host state is only restored after its last character
+static bool unicode_state_hold = false;
+// Set once the host state has been saved, and cleared once it has been restored
+static bool unicode_state_saved = false;
+
+void unicode_input_save_state(void) {
+    if (unicode_state_saved) {
+        return;
+    }
+    unicode_state_saved     = true;
     unicode_saved_led_state = host_keyboard_led_state();
 
     // Note the order matters here!
@@ -222,6 +231,37 @@ __attribute__((weak)) void unicode_input_start(void) {
     clear_mods();                    // Unregister mods to start from a clean state
     clear_weak_mods();
 
+    // For increased reliability, use numpad keys for inputting digits
+    if (unicode_config.input_mode == UNICODE_MODE_WINDOWS && !unicode_saved_led_state.num_lock) {
+        tap_code(KC_NUM_LOCK);
+    }
+}
+
+void unicode_input_restore_state(void) {
+    if (!unicode_state_saved) {
+        return;
+    }
+    unicode_state_saved = false;
+
+    switch (unicode_config.input_mode) {
+        case UNICODE_MODE_LINUX:
+            if (unicode_saved_led_state.caps_lock) {
+                tap_code(KC_CAPS_LOCK);
+            }
+            break;
+        case UNICODE_MODE_WINDOWS:
+            if (!unicode_saved_led_state.num_lock) {
+                tap_code(KC_NUM_LOCK);
+            }
+            break;
+    }
+
+    set_mods(unicode_saved_mods); // Reregister previously set mods
+}
+
+__attribute__((weak)) void unicode_input_start(void) {
+    unicode_input_save_state();
+
     switch (unicode_config.input_mode) {
         case UNICODE_MODE_MACOS:
             register_code(UNICODE_KEY_MAC);
@@ -230,10 +270,6 @@ __attribute__((weak)) void unicode_input_start(void) {
             tap_code16(UNICODE_KEY_LNX);
             break;
         case UNICODE_MODE_WINDOWS:
-            // For increased reliability, use numpad keys for inputting digits
-            if (!unicode_saved_led_state.num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             register_code(KC_LEFT_ALT);
             wait_ms(UNICODE_TYPE_DELAY);
             tap_code(KC_KP_PLUS);
@@ -260,15 +296,9 @@ __attribute__((weak)) void unicode_input_finish(void) {
             break;
         case UNICODE_MODE_LINUX:
             tap_code(KC_SPACE);
-            if (unicode_saved_led_state.caps_lock) {
-                tap_code(KC_CAPS_LOCK);
-            }
             break;
         case UNICODE_MODE_WINDOWS:
             unregister_code(KC_LEFT_ALT);
-            if (!unicode_saved_led_state.num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             break;
         case UNICODE_MODE_WINCOMPOSE:
             tap_code(KC_ENTER);
@@ -278,7 +308,9 @@ __attribute__((weak)) void unicode_input_finish(void) {
             break;
     }
 
-    set_mods(unicode_saved_mods); // Reregister previously set mods
+    if (!unicode_state_hold) {
+        unicode_input_restore_state();
+    }
 }
 
 __attribute__((weak)) void unicode_input_cancel(void) {
@@ -288,25 +320,20 @@ __attribute__((weak)) void unicode_input_cancel(void) {
             break;
         case UNICODE_MODE_LINUX:
             tap_code(KC_ESCAPE);
-            if (unicode_saved_led_state.caps_lock) {
-                tap_code(KC_CAPS_LOCK);
-            }
             break;
         case UNICODE_MODE_WINCOMPOSE:
             tap_code(KC_ESCAPE);
             break;
         case UNICODE_MODE_WINDOWS:
             unregister_code(KC_LEFT_ALT);
-            if (!unicode_saved_led_state.num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             break;
         case UNICODE_MODE_EMACS:
             tap_code16(LCTL(KC_G)); // C-g cancels
             break;
     }
 
-    set_mods(unicode_saved_mods); // Reregister previously set mods
+    unicode_state_hold = false;
+    unicode_input_restore_state();
 }
 
 // clang-format off
@@ -362,6 +389,8 @@ void register_unicode(uint32_t code_point) {
         return;
     }
 
+    // Also done by the default unicode_input_start() and unicode_input_finish(), but not necessarily by overrides
+    unicode_input_save_state();
     unicode_input_start();
     if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
         // Convert code point to UTF-16 surrogate pair on macOS
@@ -373,6 +402,18 @@ void register_unicode(uint32_t code_point) {
         register_hex32(code_point);
     }
     unicode_input_finish();
+    if (!unicode_state_hold) {
+        unicode_input_restore_state();
+    }
+}
+
+void register_unicode_sequence(const uint32_t *code_points, uint8_t count) {
+    unicode_state_hold = true;
+    for (uint8_t i = 0; i < count; i++) {
+        register_unicode(code_points[i]);
+    }
+    unicode_state_hold = false;
+    unicode_input_restore_state();
 }
 
 void send_unicode_string(const char *str) {
@@ -380,6 +421,7 @@ void send_unicode_string(const char *str) {
         return;
     }
 
+    unicode_state_hold = true;
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
@@ -388,4 +430,6 @@ void send_unicode_string(const char *str) {
             register_unicode(code_point);
         }
     }
+    unicode_state_hold = false;
+    unicode_input_restore_state();
 }
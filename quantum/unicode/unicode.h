@@ -90,18 +90,38 @@ void unicode_input_mode_set_user(uint8_t input_mode);
  */
 void unicode_input_mode_set_kb(uint8_t input_mode);
 
+/**
+ * \brief Save the caps lock, num lock and modifier state, then clear the modifiers and set up the locks for the input mode.
+ *
+ * Does nothing if the state is already saved.
+ */
+void unicode_input_save_state(void);
+
+/**
+ * \brief Restore the state saved by `unicode_input_save_state()`.
+ *
+ * Does nothing if no state is saved.
+ */
+void unicode_input_restore_state(void);
+
 /**
  * \brief Begin the Unicode input sequence. The exact behavior depends on the currently selected input mode.
+ *
+ * Calls `unicode_input_save_state()` first.
  */
 void unicode_input_start(void);
 
 /**
  * \brief Complete the Unicode input sequence. The exact behavior depends on the currently selected input mode.
+ *
+ * Calls `unicode_input_restore_state()` afterwards, unless a string or sequence is still being sent.
  */
 void unicode_input_finish(void);
 
 /**
  * \brief Cancel the Unicode input sequence. The exact behavior depends on the currently selected input mode.
+ *
+ * Calls `unicode_input_restore_state()` afterwards.
  */
 void unicode_input_cancel(void);
 
@@ -122,13 +142,29 @@ void register_hex32(uint32_t hex);
 /**
  * \brief Input a single Unicode character. A surrogate pair will be sent if required by the input mode.
  *
+ * The caps lock, num lock and modifier state is saved before `unicode_input_start()` and restored after
+ * `unicode_input_finish()`, so overrides of those only need to send the keys of the input sequence.
+ *
  * \param code_point The code point of the character to send.
  */
 void register_unicode(uint32_t code_point);
 
+/**
+ * \brief Input a sequence of Unicode characters.
+ *
+ * The caps lock, num lock and modifier state is only saved before the first character and restored after the last,
+ * instead of around each one.
+ *
+ * \param code_points The code points of the characters to send.
+ * \param count The number of code points.
+ */
+void register_unicode_sequence(const uint32_t *code_points, uint8_t count);
+
 /**
  * \brief Send a string containing Unicode characters.
  *
+ * As with `register_unicode_sequence()`, the host state is only saved and restored once for the whole string.
+ *
  * \param str The string to send.
  */
 void send_unicode_string(const char *str);
@@ -115,4 +115,16 @@ TEST_F(AudioTest, BpmConversion) {
     }
 }
 
+TEST_F(AudioTest, PackedNotePitch) {
+    EXPECT_EQ(audio_packed_note_to_pitch(NOTE_INDEX_REST), 0.0f);
+    EXPECT_EQ(audio_packed_note_to_pitch(NOTE_INDEX_B8 + 1), 0.0f);
+
+    const uint8_t indices[] = {NOTE_INDEX_C0, NOTE_INDEX_A2, NOTE_INDEX_FS3, NOTE_INDEX_A4, NOTE_INDEX_BF5, NOTE_INDEX_E6, NOTE_INDEX_B8};
+    const float   pitches[] = {NOTE_C0, NOTE_A2, NOTE_FS3, NOTE_A4, NOTE_BF5, NOTE_E6, NOTE_B8};
+    for (size_t i = 0; i < sizeof(indices); ++i) {
+        SCOPED_TRACE("note index " + testing::PrintToString(indices[i]));
+        EXPECT_NEAR(audio_packed_note_to_pitch(indices[i]), pitches[i], pitches[i] * 0.001f);
+    }
+}
+
 } // namespace
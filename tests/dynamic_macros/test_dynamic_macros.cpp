@@ -0,0 +1,264 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycodes.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacros : public TestFixture {
+   public:
+    KeymapKey key_rec1 = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey key_rec2 = KeymapKey(0, 1, 0, DM_REC2);
+    KeymapKey key_stop = KeymapKey(0, 2, 0, DM_RSTP);
+    KeymapKey key_ply1 = KeymapKey(0, 3, 0, DM_PLY1);
+    KeymapKey key_ply2 = KeymapKey(0, 4, 0, DM_PLY2);
+    KeymapKey key_a    = KeymapKey(0, 5, 0, KC_A);
+    KeymapKey key_b    = KeymapKey(0, 6, 0, KC_B);
+    KeymapKey key_c    = KeymapKey(0, 7, 0, KC_C);
+    KeymapKey key_d    = KeymapKey(0, 8, 0, KC_D);
+    KeymapKey key_e    = KeymapKey(0, 9, 0, KC_E);
+
+    void SetUp() override {
+        set_keymap({key_rec1, key_rec2, key_stop, key_ply1, key_ply2, key_a, key_b, key_c, key_d, key_e});
+    }
+
+    // Records the given keys being tapped into a slot, with the reports
+    // they send while recording ignored.
+    void record(TestDriver &driver, KeymapKey rec, std::initializer_list<KeymapKey> keys = {}) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        tap_key(rec);
+        for (KeymapKey key : keys) {
+            tap_key(key);
+        }
+        tap_key(key_stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    // Runs the main loop long enough for any macro to finish playing.
+    void play_out() {
+        idle_for(100);
+    }
+};
+
+TEST_F(DynamicMacros, RoundTrip) {
+    TestDriver driver;
+
+    record(driver, key_rec1, {key_a, key_b});
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+
+    // The macro can be played again.
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacros, BothSlots) {
+    TestDriver driver;
+
+    record(driver, key_rec1, {key_a});
+    record(driver, key_rec2, {key_b, key_c});
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply2);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacros, NestedPlayback) {
+    TestDriver driver;
+
+    record(driver, key_rec2, {key_c});
+    record(driver, key_rec1, {key_a, key_ply2, key_b});
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacros, SelfNestedPlaybackIsIgnored) {
+    TestDriver driver;
+
+    record(driver, key_rec1, {key_a, key_ply1, key_b});
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacros, RecordDuringPlaybackIsIgnored) {
+    TestDriver driver;
+
+    record(driver, key_rec1, {key_a, key_b, key_c});
+
+    // Start recording over the slot while it is still playing.
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_ply1);
+    tap_key(key_rec1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing is being recorded, so these keys are only typed.
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_D));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+
+    // And the macro is intact.
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacros, HeldKeyIsReleasedAtEnd) {
+    TestDriver driver;
+
+    // Stop recording with A still held: the macro ends holding it.
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec1);
+    key_a.press();
+    run_one_scan_loop();
+    tap_key(key_b);
+    tap_key(key_stop);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_A, KC_B));
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacros, UserHeldKeyIsKeptAtEnd) {
+    TestDriver driver;
+
+    record(driver, key_rec1, {key_a, key_b});
+
+    // Hold a key of our own while the macro plays.
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_ply1);
+    key_e.press();
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+
+    // It is still held once the macro is done.
+    EXPECT_EMPTY_REPORT(driver);
+    key_e.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacros, FullBufferDropsLaterEvents) {
+    TestDriver driver;
+
+    // Leave slot 2 empty, so slot 1 has the whole buffer.
+    record(driver, key_rec2);
+
+    // Plain key events take four bytes and the events of a tapped key
+    // five. The buffer is full once D and E are down, and once the tap
+    // does not fit, the release of D must not be stored either, or the
+    // macro would press E and never release it.
+    KeymapKey key_tap = KeymapKey(0, 0, 1, LT(1, KC_F));
+    add_key(key_tap);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_keys(key_a, key_b, key_c);
+    key_d.press();
+    run_one_scan_loop();
+    key_e.press();
+    run_one_scan_loop();
+    tap_key(key_tap);
+    key_d.release();
+    run_one_scan_loop();
+    key_e.release();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_out();
+    VERIFY_AND_CLEAR(driver);
+
+    // Free the buffer again for the other tests.
+    record(driver, key_rec1);
+}
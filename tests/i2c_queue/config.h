@@ -0,0 +1,9 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define I2C_QUEUE_SIZE 4
+#define I2C_QUEUE_BUFFER_SIZE 40
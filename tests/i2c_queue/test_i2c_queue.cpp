@@ -0,0 +1,185 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "i2c_queue.h"
+}
+
+namespace {
+
+struct Transfer {
+    bool                 read;
+    uint8_t              devaddr;
+    uint8_t              regaddr;
+    std::vector<uint8_t> data;
+};
+
+std::vector<Transfer> transfers;
+uint8_t               failures_left = 0;
+
+i2c_status_t next_status() {
+    if (failures_left) {
+        failures_left--;
+        return I2C_STATUS_TIMEOUT;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+} // namespace
+
+extern "C" i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    transfers.push_back({false, devaddr, regaddr, std::vector<uint8_t>(data, data + length)});
+    return next_status();
+}
+
+extern "C" i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = regaddr + i;
+    }
+    transfers.push_back({true, devaddr, regaddr, std::vector<uint8_t>(data, data + length)});
+    return next_status();
+}
+
+class I2CQueue : public TestFixture {
+   public:
+    void SetUp() override {
+        i2c_queue_flush();
+        transfers.clear();
+        failures_left = 0;
+    }
+};
+
+static void record_status(i2c_status_t status, void *context) {
+    static_cast<std::vector<i2c_status_t> *>(context)->push_back(status);
+}
+
+TEST_F(I2CQueue, WritesAreDeferredAndPerformedInOrder) {
+    const uint8_t first[]  = {1, 2, 3};
+    const uint8_t second[] = {4, 5};
+
+    i2c_queue_write_register(0x20, 0x10, first, sizeof(first), 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+    i2c_queue_write_register(0x20, 0x11, second, sizeof(second), 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+    EXPECT_TRUE(transfers.empty());
+    EXPECT_FALSE(i2c_queue_is_empty());
+
+    i2c_queue_task();
+    ASSERT_EQ(transfers.size(), 1u);
+    EXPECT_EQ(transfers[0].regaddr, 0x10);
+    EXPECT_EQ(transfers[0].data, std::vector<uint8_t>(first, first + sizeof(first)));
+
+    i2c_queue_task();
+    ASSERT_EQ(transfers.size(), 2u);
+    EXPECT_EQ(transfers[1].regaddr, 0x11);
+    EXPECT_TRUE(i2c_queue_is_empty());
+}
+
+TEST_F(I2CQueue, WriteDataIsSnapshotWhenQueued) {
+    uint8_t frame[16];
+    memset(frame, 0xAA, sizeof(frame));
+    i2c_queue_write_register(0x20, 0x00, frame, sizeof(frame), 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+
+    // The next frame is drawn before the queued one has been sent
+    memset(frame, 0x55, sizeof(frame));
+    i2c_queue_write_register(0x20, 0x00, frame, sizeof(frame), 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+
+    i2c_queue_flush();
+    ASSERT_EQ(transfers.size(), 2u);
+    EXPECT_EQ(transfers[0].data, std::vector<uint8_t>(16, 0xAA));
+    EXPECT_EQ(transfers[1].data, std::vector<uint8_t>(16, 0x55));
+}
+
+TEST_F(I2CQueue, HighPriorityGoesFirst) {
+    const uint8_t data = 0;
+    uint8_t       read[2];
+
+    i2c_queue_write_register(0x20, 0x01, &data, 1, 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+    i2c_queue_write_register(0x20, 0x02, &data, 1, 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+    i2c_queue_read_register(0x30, 0x40, read, sizeof(read), 100, 0, I2C_QUEUE_PRIORITY_HIGH, NULL, NULL);
+
+    i2c_queue_task();
+    ASSERT_EQ(transfers.size(), 1u);
+    EXPECT_TRUE(transfers[0].read);
+    EXPECT_EQ(read[0], 0x40);
+    EXPECT_EQ(read[1], 0x41);
+
+    i2c_queue_flush();
+    ASSERT_EQ(transfers.size(), 3u);
+    EXPECT_EQ(transfers[1].regaddr, 0x01);
+    EXPECT_EQ(transfers[2].regaddr, 0x02);
+}
+
+TEST_F(I2CQueue, PersistenceRetriesFailedWrites) {
+    const uint8_t                data = 0;
+    std::vector<i2c_status_t> statuses;
+
+    failures_left = 2;
+    i2c_queue_write_register(0x20, 0x01, &data, 1, 100, 3, I2C_QUEUE_PRIORITY_LOW, record_status, &statuses);
+    i2c_queue_flush();
+    EXPECT_EQ(transfers.size(), 3u);
+
+    failures_left = 2;
+    i2c_queue_write_register(0x20, 0x02, &data, 1, 100, 0, I2C_QUEUE_PRIORITY_LOW, record_status, &statuses);
+    i2c_queue_flush();
+    EXPECT_EQ(transfers.size(), 4u);
+
+    ASSERT_EQ(statuses.size(), 2u);
+    EXPECT_EQ(statuses[0], I2C_STATUS_SUCCESS);
+    EXPECT_EQ(statuses[1], I2C_STATUS_TIMEOUT);
+}
+
+TEST_F(I2CQueue, FullQueuePerformsOldestJobs) {
+    const uint8_t data = 0;
+    for (uint8_t i = 0; i < I2C_QUEUE_SIZE + 2; i++) {
+        i2c_queue_write_register(0x20, i, &data, 1, 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+    }
+    ASSERT_EQ(transfers.size(), 2u);
+    EXPECT_EQ(transfers[0].regaddr, 0);
+    EXPECT_EQ(transfers[1].regaddr, 1);
+
+    i2c_queue_flush();
+    ASSERT_EQ(transfers.size(), I2C_QUEUE_SIZE + 2u);
+    for (uint8_t i = 0; i < I2C_QUEUE_SIZE + 2; i++) {
+        EXPECT_EQ(transfers[i].regaddr, i);
+    }
+}
+
+TEST_F(I2CQueue, DataBufferWrapsAround) {
+    // Block sizes that do not divide the buffer size, so that writes have to
+    // skip the end of the buffer and wrap around to its start
+    std::vector<std::vector<uint8_t>> sent;
+    for (uint8_t i = 0; i < 30; i++) {
+        std::vector<uint8_t> block(7 + (i % 3) * 5, i);
+        sent.push_back(block);
+        i2c_queue_write_register(0x20, i, block.data(), block.size(), 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+        if (i % 4 == 0) {
+            i2c_queue_task();
+        }
+    }
+    i2c_queue_flush();
+
+    ASSERT_EQ(transfers.size(), sent.size());
+    for (size_t i = 0; i < sent.size(); i++) {
+        EXPECT_EQ(transfers[i].regaddr, i);
+        EXPECT_EQ(transfers[i].data, sent[i]);
+    }
+}
+
+TEST_F(I2CQueue, OversizedWriteIsPerformedInOrder) {
+    const uint8_t data = 0;
+    uint8_t       large[I2C_QUEUE_BUFFER_SIZE + 1];
+    memset(large, 0x77, sizeof(large));
+
+    i2c_queue_write_register(0x20, 0x01, &data, 1, 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+    i2c_queue_write_register(0x20, 0x02, large, sizeof(large), 100, 0, I2C_QUEUE_PRIORITY_LOW, NULL, NULL);
+
+    ASSERT_EQ(transfers.size(), 2u);
+    EXPECT_EQ(transfers[0].regaddr, 0x01);
+    EXPECT_EQ(transfers[1].regaddr, 0x02);
+    EXPECT_EQ(transfers[1].data.size(), sizeof(large));
+    EXPECT_TRUE(i2c_queue_is_empty());
+}
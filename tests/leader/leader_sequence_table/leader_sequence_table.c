@@ -0,0 +1,22 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+const uint16_t PROGMEM lead_a[]      = {KC_A, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM lead_a_b[]    = {KC_A, KC_B, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM lead_x_y[]    = {KC_X, KC_Y, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM lead_long[]   = {KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM lead_action[] = {KC_Z, LEADER_SEQUENCE_END};
+
+static void send_9(void) {
+    tap_code(KC_9);
+}
+
+leader_sequence_t leader_sequences[] = {
+    LEADER_SEQUENCE(lead_a, KC_1),
+    LEADER_SEQUENCE(lead_a_b, KC_2),
+    LEADER_SEQUENCE(lead_x_y, KC_3),
+    LEADER_SEQUENCE(lead_long, KC_6),
+    LEADER_SEQUENCE_ACTION(lead_action, send_9),
+};
@@ -56,6 +56,31 @@ TEST_F(TapDance, DoubleTap) {
     run_one_scan_loop();
 }
 
+TEST_F(TapDance, StateReleasedAfterReset) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_esc_caps = KeymapKey{0, 1, 0, TD(TD_ESC_CAPS)};
+
+    set_keymap({key_esc_caps});
+
+    EXPECT_EQ(tap_dance_get_state(TD_ESC_CAPS), nullptr);
+
+    /* The state is only held while the dance is in progress */
+    key_esc_caps.press();
+    run_one_scan_loop();
+    key_esc_caps.release();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    ASSERT_NE(tap_dance_get_state(TD_ESC_CAPS), nullptr);
+    EXPECT_EQ(tap_dance_get_state(TD_ESC_CAPS)->count, 1);
+    EXPECT_EQ(TAP_DANCE_KEYCODE(tap_dance_get_state(TD_ESC_CAPS)), TD(TD_ESC_CAPS));
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(TAPPING_TERM + 1);
+    EXPECT_EQ(tap_dance_get_state(TD_ESC_CAPS), nullptr);
+}
+
 TEST_F(TapDance, DoubleTapWithMod) {
     TestDriver driver;
     InSequence s;
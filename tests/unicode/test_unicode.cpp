@@ -84,3 +84,53 @@ TEST_F(Unicode, sends_unicode_string) {
 
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(Unicode, toggles_caps_lock_once_per_string) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    driver.set_leds((led_t){.caps_lock = true}.raw);
+
+    {
+        testing::InSequence s;
+
+        EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_UNICODE(driver, 0x03A8);
+        EXPECT_UNICODE(driver, 0x03A9);
+        EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    send_unicode_string("ΨΩ");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Unicode, input_start_and_cancel_restore_state) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    driver.set_leds((led_t){.caps_lock = true}.raw);
+    set_mods(MOD_BIT(KC_LEFT_SHIFT));
+
+    {
+        testing::InSequence s;
+
+        EXPECT_REPORT(driver, (KC_CAPS_LOCK, KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_U));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_ESCAPE));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    unicode_input_start();
+    EXPECT_EQ(get_mods(), 0);
+    unicode_input_cancel();
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LEFT_SHIFT));
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,63 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+
+// A keymap override that only sends the keys, as the docs describe.
+extern "C" void unicode_input_finish(void) {
+    tap_code(KC_SPACE);
+}
+
+class UnicodeFinishOverride : public TestFixture {};
+
+TEST_F(UnicodeFinishOverride, restores_state_once_per_string) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    driver.set_leds((led_t){.caps_lock = true}.raw);
+    set_mods(MOD_BIT(KC_LEFT_SHIFT));
+
+    // The state is saved and restored around each string, not just the first.
+    for (int i = 0; i < 2; i++) {
+        {
+            testing::InSequence s;
+
+            EXPECT_REPORT(driver, (KC_CAPS_LOCK, KC_LEFT_SHIFT));
+            EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+            EXPECT_UNICODE(driver, 0x03A8);
+            EXPECT_UNICODE(driver, 0x03A9);
+            EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+        send_unicode_string("ΨΩ");
+        EXPECT_EQ(get_mods(), MOD_BIT(KC_LEFT_SHIFT));
+
+        VERIFY_AND_CLEAR(driver);
+    }
+}
+
+TEST_F(UnicodeFinishOverride, restores_state_after_single_character) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    driver.set_leds((led_t){.caps_lock = true}.raw);
+    set_mods(MOD_BIT(KC_LEFT_SHIFT));
+
+    {
+        testing::InSequence s;
+
+        EXPECT_REPORT(driver, (KC_CAPS_LOCK, KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_UNICODE(driver, 0x03A8);
+        EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    register_unicode(0x03A8);
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LEFT_SHIFT));
+
+    VERIFY_AND_CLEAR(driver);
+}
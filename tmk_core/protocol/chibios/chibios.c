@@ -77,6 +77,10 @@ host_driver_t chibios_driver = {
 #endif
 };
 
+#ifdef MIDI_ENABLE
+void midi_usb_task(void);
+#endif
+
 #ifdef VIRTSER_ENABLE
 void virtser_task(void);
 #endif
@@ -200,6 +204,9 @@ void protocol_pre_task(void) {
 }
 
 void protocol_post_task(void) {
+#ifdef MIDI_ENABLE
+    midi_usb_task();
+#endif
 #ifdef VIRTSER_ENABLE
     virtser_task();
 #endif
@@ -526,13 +526,19 @@ void raw_hid_task(void) {
 #ifdef MIDI_ENABLE
 
 void send_midi_packet(MIDI_EventPacket_t *event) {
-    send_report(USB_ENDPOINT_IN_MIDI, (uint8_t *)event, sizeof(MIDI_EventPacket_t));
+    // Packets are collected in the endpoint buffer and sent together by
+    // midi_usb_task, so a chord or a burst of CCs goes out in one transfer.
+    send_report_buffered(USB_ENDPOINT_IN_MIDI, (uint8_t *)event, sizeof(MIDI_EventPacket_t));
 }
 
 bool recv_midi_packet(MIDI_EventPacket_t *const event) {
     return receive_report(USB_ENDPOINT_OUT_MIDI, (uint8_t *)event, sizeof(MIDI_EventPacket_t));
 }
 
+void midi_usb_task(void) {
+    flush_report_buffered(USB_ENDPOINT_IN_MIDI, false);
+}
+
 #endif
 
 #ifdef VIRTSER_ENABLE
@@ -572,6 +578,12 @@ void virtser_send(const uint8_t byte) {
     send_report_buffered(USB_ENDPOINT_IN_CDC_DATA, (void *)&byte, sizeof(byte));
 }
 
+void virtser_send_buffer(const uint8_t *data, uint8_t length) {
+    // Unbuffered, so the packet (and anything queued by virtser_send before
+    // it) goes out now instead of on the next virtser_task.
+    send_report(USB_ENDPOINT_IN_CDC_DATA, (void *)data, length);
+}
+
 __attribute__((weak)) void virtser_recv(uint8_t c) {
     // Ignore by default
 }
@@ -23,24 +23,34 @@
 #include "util.h"
 #include <string.h>
 
+/* Index of the keys currently held in the 6KRO keyboard_report.
+ *
+ * The report itself stays the source of truth for what goes out on the
+ * wire (slot order is preserved), but membership and emptiness queries are
+ * answered from this bitmap instead of scanning the key slots.
+ */
+static uint8_t keyboard_report_bits[256 / 8];
+static uint8_t keyboard_report_count = 0;
+
+static inline bool keyboard_report_bit(uint8_t code) {
+    return keyboard_report_bits[code >> 3] & (1 << (code & 7));
+}
+
 /** \brief has_anykey
  *
- * FIXME: Needs doc
+ * Returns non-zero if any non-modifier key is held in the current report.
  */
 uint8_t has_anykey(void) {
-    uint8_t  cnt = 0;
-    uint8_t* p   = keyboard_report->keys;
-    uint8_t  lp  = sizeof(keyboard_report->keys);
 #ifdef NKRO_ENABLE
     if (host_can_send_nkro() && keymap_config.nkro) {
-        p  = nkro_report->bits;
-        lp = sizeof(nkro_report->bits);
+        uint8_t cnt = 0;
+        for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+            if (nkro_report->bits[i]) cnt++;
+        }
+        return cnt;
     }
 #endif
-    while (lp--) {
-        if (*p++) cnt++;
-    }
-    return cnt;
+    return keyboard_report_count;
 }
 
 /** \brief get_first_key
@@ -77,12 +87,7 @@ bool is_key_pressed(uint8_t key) {
         }
     }
 #endif
-    for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
-        if (keyboard_report->keys[i] == key) {
-            return true;
-        }
-    }
-    return false;
+    return keyboard_report_bit(key);
 }
 
 /** \brief add key byte
@@ -156,7 +161,18 @@ void add_key_to_report(uint8_t key) {
         return;
     }
 #endif
-    add_key_byte(keyboard_report, key);
+    if (key == KC_NO || keyboard_report_bit(key) || keyboard_report_count >= KEYBOARD_REPORT_KEYS) {
+        return;
+    }
+    // the key is known not to be present, so just take the first free slot
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i] == KC_NO) {
+            keyboard_report->keys[i] = key;
+            keyboard_report_bits[key >> 3] |= 1 << (key & 7);
+            keyboard_report_count++;
+            return;
+        }
+    }
 }
 
 /** \brief del key from report
@@ -170,7 +186,12 @@ void del_key_from_report(uint8_t key) {
         return;
     }
 #endif
+    if (key == KC_NO || !keyboard_report_bit(key)) {
+        return;
+    }
     del_key_byte(keyboard_report, key);
+    keyboard_report_bits[key >> 3] &= ~(1 << (key & 7));
+    keyboard_report_count--;
 }
 
 /** \brief clear key from report
@@ -186,6 +207,8 @@ void clear_keys_from_report(void) {
     }
 #endif
     memset(keyboard_report->keys, 0, sizeof(keyboard_report->keys));
+    memset(keyboard_report_bits, 0, sizeof(keyboard_report_bits));
+    keyboard_report_count = 0;
 }
 
 #ifdef MOUSE_ENABLE